@@ -0,0 +1,123 @@
+#ifndef CATHEDRAL_ARENA_H
+#define CATHEDRAL_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Cathedral {
+
+    // Bump allocator for per-iteration scratch. Nothing is freed individually;
+    // reset() rewinds it, and if the last cycle overflowed into extra chunks
+    // they are merged into one so the next cycle of the same size fits without
+    // touching the heap.
+    class MonotonicArena {
+    public:
+        explicit MonotonicArena(std::size_t initialBytes = 64 * 1024);
+        ~MonotonicArena();
+        MonotonicArena(const MonotonicArena&) = delete;
+        MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+        void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+        // Value-initialised array; T must not need destruction since reset() runs no destructors
+        template <typename T>
+        T* allocateArray(std::size_t count) {
+            static_assert(std::is_trivially_destructible<T>::value, "arena objects are never destroyed");
+            T* items = static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+            for (std::size_t i = 0; i < count; ++i) {
+                ::new (static_cast<void*>(items + i)) T();
+            }
+            return items;
+        }
+
+        void reset();
+
+        std::size_t bytesUsed() const { return used; }
+        std::size_t highWater() const { return peak; }
+        std::size_t capacity() const { return totalCapacity; }
+        std::uint64_t chunkAllocations() const { return chunksAllocated; }  // Heap calls made so far
+
+    private:
+        struct Chunk {
+            Chunk* next;
+            std::size_t size;  // Usable bytes after the header
+        };
+
+        void addChunk(std::size_t minBytes);
+        void releaseChunks();
+
+        Chunk* head = nullptr;  // Current chunk; older ones follow through next
+        char* cursor = nullptr;
+        char* end = nullptr;
+        std::size_t used = 0;
+        std::size_t peak = 0;
+        std::size_t totalCapacity = 0;
+        std::uint64_t chunksAllocated = 0;
+    };
+
+    // Free-list pool of equally sized, cache-line aligned blocks, e.g. the
+    // N-double vectors of one analysis. Blocks are carved from slabs that live
+    // until the pool is destroyed.
+    class BlockPool {
+    public:
+        static constexpr std::size_t kBlockAlignment = 64;
+
+        explicit BlockPool(std::size_t blockBytes, std::size_t blocksPerSlab = 32);
+        ~BlockPool();
+        BlockPool(const BlockPool&) = delete;
+        BlockPool& operator=(const BlockPool&) = delete;
+
+        void* allocate();
+        void deallocate(void* block);
+
+        template <typename T>
+        T* allocateAs() {
+            static_assert(alignof(T) <= kBlockAlignment, "block alignment too small");
+            return static_cast<T*>(allocate());
+        }
+
+        // Makes sure `blocks` more allocations succeed without growing
+        void reserve(std::size_t blocks);
+
+        std::size_t blockSize() const { return blockBytes; }
+        std::size_t blocksInUse() const { return inUse; }
+        std::size_t capacity() const { return totalBlocks; }
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        void addSlab(std::size_t blocks);
+
+        std::size_t blockBytes;
+        std::size_t blocksPerSlab;
+        std::vector<void*> slabs;
+        FreeBlock* freeList = nullptr;
+        std::size_t freeCount = 0;
+        std::size_t inUse = 0;
+        std::size_t totalBlocks = 0;
+    };
+
+    // Memory owned by one analysis run: a scratch arena the loop resets every
+    // iteration plus one pool per vector/matrix block size. Not thread-safe;
+    // each worker runs its own analysis, so there is no allocator contention.
+    class AnalysisMemory {
+    public:
+        explicit AnalysisMemory(std::size_t scratchBytes = 64 * 1024) : scratchArena(scratchBytes) {}
+
+        MonotonicArena& scratch() { return scratchArena; }
+        BlockPool& pool(std::size_t blockBytes);  // Created on first request for that size
+
+    private:
+        MonotonicArena scratchArena;
+        std::vector<std::unique_ptr<BlockPool>> pools;
+    };
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_ARENA_H
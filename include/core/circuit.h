@@ -21,8 +21,10 @@ namespace Cathedral {
         ~Circuit();
 
         void addComponent(const std::string& type, double value, int node1, int node2);
+        std::vector<std::string> addComponents(const std::vector<CircuitComponent>& parts);  // Bulk add; returns assigned IDs
         void removeComponent(const std::string& id);
         void listComponents() const;
+        const std::unordered_map<std::string, CircuitComponent>& getComponents() const { return components; }
         
     private:
         std::unordered_map<std::string, CircuitComponent> components;
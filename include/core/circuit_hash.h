@@ -0,0 +1,46 @@
+#ifndef CATHEDRAL_CIRCUIT_HASH_H
+#define CATHEDRAL_CIRCUIT_HASH_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "core/circuit.h"
+
+namespace Cathedral {
+
+    // 128-bit content key of a canonical circuit plus analysis options
+    struct CircuitKey {
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+
+        std::string toHex() const;
+        bool operator==(const CircuitKey& other) const { return high == other.high && low == other.low; }
+        bool operator!=(const CircuitKey& other) const { return !(*this == other); }
+    };
+
+    // Connected group of components (joined through non-ground nodes) and its own key
+    struct SubcircuitKey {
+        CircuitKey key;
+        std::vector<std::string> componentIds;
+        std::vector<int> nodes;
+        std::string canonical;  // Canonical text of just this group, nodes ranked within it
+    };
+
+    // One line per component, sorted, independent of component IDs, insertion
+    // order and order-preserving node renumbering (nodes are written by rank).
+    // Values are written as exact hex floats so equal keys mean equal circuits.
+    std::string CanonicalizeCircuit(const Circuit& circuit);
+
+    // Exact text a key is hashed from: format version, canonical circuit and
+    // options. The result cache stores it to verify hits.
+    std::string CircuitKeyText(const std::string& canonical, const std::string& analysisOptions);
+
+    CircuitKey HashCircuit(const Circuit& circuit, const std::string& analysisOptions);
+
+    // Keys for each connected subcircuit, so unchanged parts of an edited
+    // circuit can reuse memoized results.
+    std::vector<SubcircuitKey> HashSubcircuits(const Circuit& circuit, const std::string& analysisOptions);
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_CIRCUIT_HASH_H
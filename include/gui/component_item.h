@@ -6,17 +6,22 @@
 #include <QString>
 #include <QList>
 #include <QPointF>
+#include <QPointer>
+
+class SchematicBatch;
 
 class ComponentItem : public QObject, public QGraphicsItem {
     Q_OBJECT
 
 public:
     ComponentItem(const QString& type, int x, int y);
+    ~ComponentItem();
     QString getType() const { return componentType; }
     QPointF getNearestTerminal(const QPointF& clickPos) const;
 
     QRectF boundingRect() const override;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+    static void paintSymbol(QPainter *painter, const QString& type);  // Body and terminals, shared with the GL symbol atlas
 
 signals:
     void positionChanged(ComponentItem *component);
@@ -25,11 +30,13 @@ protected:
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
     void mouseMoveEvent(QGraphicsSceneMouseEvent *event) override;
     void mouseReleaseEvent(QGraphicsSceneMouseEvent *event) override;
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
 
 private:
     QString componentType;
     bool isDragging;
     QPointF lastPosition;
+    QPointer<SchematicBatch> batch;  // Batched renderer of the scene this item is in
     QList<QPointF> terminals;  // List of terminal positions relative to component center
     void initializeTerminals();  // Initialize terminal positions based on component type
 };
@@ -0,0 +1,96 @@
+#ifndef CONSOLE_DOCK_H
+#define CONSOLE_DOCK_H
+
+#include <QDockWidget>
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QMutex>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+class QListView;
+class QMenu;
+class QTimer;
+
+struct ConsoleEntry {
+    QString category;
+    QString text;
+};
+
+// Ring buffer of console lines; the oldest lines fall off once the cap is reached
+class ConsoleModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    enum Roles { CategoryRole = Qt::UserRole + 1 };
+
+    explicit ConsoleModel(int lineCap, QObject *parent = nullptr);
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    void appendBatch(const QVector<ConsoleEntry> &batch);
+    void clear();
+    int lineCap() const { return capacity; }
+
+private:
+    const ConsoleEntry &at(int row) const { return ring[(head + row) % capacity]; }
+
+    QVector<ConsoleEntry> ring;
+    int capacity;
+    int head = 0;
+    int count = 0;
+};
+
+// Hides rows whose category has been switched off
+class ConsoleFilterModel : public QSortFilterProxyModel {
+    Q_OBJECT
+
+public:
+    explicit ConsoleFilterModel(QObject *parent = nullptr) : QSortFilterProxyModel(parent) {}
+    void setCategoryVisible(const QString &category, bool visible);
+    bool hasHiddenCategories() const { return !hiddenCategories.isEmpty(); }
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    QSet<QString> hiddenCategories;
+};
+
+// Console dock shown under the schematic. append() is safe from any thread:
+// messages are queued and handed to the model in timer-coalesced batches, so
+// bursts of thousands of lines cost one model update per flush interval.
+class ConsoleDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    explicit ConsoleDock(const QString &title, QWidget *parent = nullptr, int lineCap = 100000);
+    ~ConsoleDock();
+
+    void append(const QString &text, const QString &category = "Info");
+    void setCategoryVisible(const QString &category, bool visible);
+    void clear();
+
+    // Routes qDebug()/qWarning() output into this console until it is destroyed
+    void installMessageHandler();
+
+private slots:
+    void flushPending();
+
+private:
+    void registerCategory(const QString &category);
+
+    ConsoleModel *model;
+    ConsoleFilterModel *filter;
+    QListView *view;
+    QMenu *filterMenu;
+    QTimer *flushTimer;
+    QSet<QString> knownCategories;
+
+    QMutex pendingMutex;
+    QVector<ConsoleEntry> pending;
+    int droppedMessages = 0;
+};
+
+#endif // CONSOLE_DOCK_H
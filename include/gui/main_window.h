@@ -4,10 +4,18 @@
 #include <QMainWindow>
 #include <QGraphicsView>
 #include <QGraphicsScene>
-#include <QTextEdit>
+#include <QFutureWatcher>
+#include <memory>
 #include "core/circuit.h"
 #include "gui/component_item.h"
 #include "gui/wire_item.h"
+#include "gui/console_dock.h"
+#include "gui/netlist_import.h"
+#include "gui/schematic_view.h"
+
+namespace Cathedral {
+    class JobScheduler;
+}
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -25,9 +33,15 @@ public:
 private slots:
     void addResistor();
     void addCapacitor();
+    void importNetlist();
+    void onNetlistLoaded();
+    void runNetlistBatch();
+    void cancelSimulations();
+    void onSimulationJobFinished();
     void listCircuit();
     void toggleWireMode(bool enabled);
     void toggleDeleteMode(bool enabled);  // Add slot for Delete Mode
+    void toggleOpenGLViewport(bool enabled);
     void onComponentMoved(ComponentItem *component);
 
 private:
@@ -36,10 +50,12 @@ private:
     void createDockWidgets();
     void deleteComponent(ComponentItem *component);  // Helper to delete a component
     void deleteWire(WireItem *wire);  // Helper to delete a wire
+    void insertComponents(const NetlistImport &netlist);  // Batch insert with scene indexing suspended
+    Cathedral::JobScheduler *jobScheduler();  // Created on first use
 
-    QGraphicsView *schematicView;
+    SchematicView *schematicView;
     QGraphicsScene *scene;
-    QTextEdit *logConsole;
+    ConsoleDock *logConsole;
     Cathedral::Circuit circuit;
     int componentX = 0;
     bool wireMode = false;
@@ -51,12 +67,15 @@ private:
     QAction *toggleDeleteModeAction = nullptr;  // Add for Delete Mode
     QAction *addResistorAction = nullptr;
     QAction *addCapacitorAction = nullptr;
+    QFutureWatcher<NetlistImport> *importWatcher = nullptr;
+    std::unique_ptr<Cathedral::JobScheduler> scheduler;
 
     struct WireConnection {
         ComponentItem *startComponent;
         QPointF startTerminal;
         ComponentItem *endComponent;
         QPointF endTerminal;
+        QPointF startLocal, endLocal;  // Terminals in component coordinates, followed on moves
         QList<WireItem*> segments;
     };
     QList<WireConnection> wireConnections;
@@ -0,0 +1,29 @@
+#ifndef NETLIST_IMPORT_H
+#define NETLIST_IMPORT_H
+
+#include <QPointF>
+#include <QString>
+#include <QVector>
+#include <vector>
+#include "core/circuit.h"
+
+// Parsed and placed netlist, produced off the UI thread and inserted in one batch
+struct NetlistImport {
+    bool ok = false;
+    QString filename;
+    std::vector<Cathedral::CircuitComponent> components;
+    QVector<QPointF> positions;  // Scene position of each component
+    qint64 parseMs = 0;
+    qint64 layoutMs = 0;
+};
+
+// Graph-based placement: each group of components joined through non-ground
+// nets is laid out in BFS layers (one column per layer, wrapped when a layer is
+// tall) and the groups are packed onto shelves. Runs in O(components + pins).
+QVector<QPointF> layoutComponents(const std::vector<Cathedral::CircuitComponent>& components, const QPointF& origin);
+
+// Parses and lays out a netlist file; touches no QObject, so it is safe to run
+// with QtConcurrent.
+NetlistImport loadNetlist(const QString& filename, const QPointF& origin);
+
+#endif // NETLIST_IMPORT_H
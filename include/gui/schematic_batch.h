@@ -0,0 +1,100 @@
+#ifndef SCHEMATIC_BATCH_H
+#define SCHEMATIC_BATCH_H
+
+#include <QObject>
+#include <QHash>
+#include <QLineF>
+#include <QPair>
+#include <QPoint>
+#include <QPointF>
+#include <QRectF>
+#include <QRgb>
+#include <QString>
+#include <QVector>
+
+class QGraphicsItem;
+class QGraphicsScene;
+class WireItem;
+class ComponentItem;
+
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+// Qt 5 has no qHash(QPoint); tile keys hash like the pair of their coordinates
+inline uint qHash(const QPoint &key, uint seed = 0) {
+    return qHash(qMakePair(key.x(), key.y()), seed);
+}
+#endif
+
+// Per-scene registry of wire segments and symbol positions, bucketed into
+// square tiles so the view can cull and draw them in a few batched calls
+// instead of painting every item. Items register themselves when they enter
+// or leave the scene. While batching is enabled unselected items carry
+// ItemHasNoContents, so the scene does not visit them when painting; since
+// that also hides them from the scene's hit tests, the view resolves clicks
+// and rubber bands on batched items through itemAt() and selectIn().
+class SchematicBatch : public QObject {
+    Q_OBJECT
+
+public:
+    static SchematicBatch *forScene(QGraphicsScene *scene);
+
+    bool isEnabled() const { return enabled; }
+    void setEnabled(bool on);
+    bool symbolsBatched() const { return enabled && instancedSymbols; }
+    void setInstancedSymbols(bool on);  // Set by the view once it knows the GL context supports instancing
+
+    void addWire(WireItem *wire, const QLineF &line, QRgb color);
+    void removeWire(WireItem *wire);
+    void addSymbol(ComponentItem *symbol, const QString &type, const QPointF &pos);
+    void removeSymbol(ComponentItem *symbol);
+
+    // Topmost batched item under `scenePos`, symbols before wires
+    QGraphicsItem *itemAt(const QPointF &scenePos) const;
+    // Gives `item` its contents back so the scene can hit-test and grab it;
+    // the previously active item is batched again. Pass nullptr to clear.
+    void setActiveItem(QGraphicsItem *item);
+    void selectIn(const QRectF &sceneRect);  // Selects batched items intersecting the rectangle
+    void itemSelectionChanged(QGraphicsItem *item);  // Called by items; selected items paint their own highlight
+
+    // Geometry of the tiles intersecting `rect`, grouped by wire colour and
+    // symbol type. Existing vectors are emptied but keep their capacity.
+    void collect(const QRectF &rect, QHash<QRgb, QVector<QLineF>> &lines,
+                 QHash<QString, QVector<QPointF>> &symbols) const;
+
+    // Tile-level access for views that keep per-tile GPU buffers. Every edit
+    // gives the touched tile a new revision, so a view only rebuilds the
+    // buffers of tiles whose revision differs from the one it uploaded.
+    void tilesIn(const QRectF &rect, QVector<QPoint> &keys) const;  // `keys` is emptied first
+    quint64 tileRevision(const QPoint &key) const;  // 0 for a tile that was never used
+    void tileGeometry(const QPoint &key, QHash<QRgb, QVector<QLineF>> &lines,
+                      QHash<QString, QVector<QPointF>> &symbols) const;
+
+private:
+    explicit SchematicBatch(QGraphicsScene *scene);
+
+    struct Tile {
+        QRectF bounds;  // Grows to cover everything ever placed in the tile
+        quint64 revision = 0;
+        QHash<QRgb, QHash<WireItem*, QLineF>> wires;
+        QHash<QString, QHash<ComponentItem*, QPointF>> symbols;
+    };
+
+    static QPoint tileOf(const QPointF &point);
+    void refresh();
+    void updateItemFlags();
+    void updateFlag(QGraphicsItem *item, bool batched);
+    void refreshFlag(QGraphicsItem *item);
+    void unlinkWire(WireItem *wire);
+    void unlinkSymbol(ComponentItem *symbol);
+    void touch(Tile &tile) { tile.revision = ++lastRevision; }
+
+    QGraphicsScene *scene;
+    QHash<QPoint, Tile> tiles;
+    QHash<WireItem*, QPair<QPoint, QRgb>> wireSlots;
+    QHash<ComponentItem*, QPair<QPoint, QString>> symbolSlots;
+    QGraphicsItem *activeItem = nullptr;
+    quint64 lastRevision = 0;
+    bool enabled = false;
+    bool instancedSymbols = false;
+};
+
+#endif // SCHEMATIC_BATCH_H
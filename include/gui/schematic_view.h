@@ -0,0 +1,77 @@
+#ifndef SCHEMATIC_VIEW_H
+#define SCHEMATIC_VIEW_H
+
+#include <QGraphicsView>
+#include <QHash>
+#include <QOpenGLBuffer>
+#include <QPointer>
+#include <QVector>
+#include "gui/schematic_batch.h"
+
+class QOpenGLShaderProgram;
+class QOpenGLTexture;
+
+// Schematic canvas. In raster mode items paint themselves and only dirty
+// regions are repainted. In OpenGL mode the viewport is a QOpenGLWidget and
+// the view draws, per visible tile, all wires of one colour from a single
+// vertex buffer and all symbols of one type as instanced textured quads.
+// Those buffers persist across frames; only tiles edited since their last
+// upload are rebuilt.
+class SchematicView : public QGraphicsView {
+    Q_OBJECT
+
+public:
+    explicit SchematicView(QWidget *parent = nullptr);
+    ~SchematicView();
+
+    void setOpenGLEnabled(bool enabled);
+    bool isOpenGLEnabled() const { return openGL; }
+
+protected:
+    void drawBackground(QPainter *painter, const QRectF &rect) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    void drawGrid(QPainter *painter, const QRectF &rect);
+    void activateItemAt(const QPoint &viewPos);
+    struct GLBatch {
+        QOpenGLBuffer buffer;  // Line vertices, or symbol instance offsets
+        int count = 0;         // Vertices or instances to draw
+    };
+    struct TileBuffers {
+        quint64 revision = 0;  // SchematicBatch::tileRevision() when uploaded
+        QHash<QRgb, GLBatch> wires;
+        QHash<QString, GLBatch> symbols;
+    };
+
+    void drawBatchesGL(QPainter *painter, const QRectF &rect);
+    void drawBatchesRaster(QPainter *painter);
+    void updateTileBuffers(const QPoint &key, TileBuffers &buffers);
+    void releaseTileBuffers();
+    bool initializeGLResources();
+    void releaseGLResources();
+    QOpenGLTexture *symbolTexture(const QString &type);
+    SchematicBatch *currentBatch();
+
+    bool openGL = false;
+    QPointer<SchematicBatch> batch;
+
+    // Scratch for the raster fallback and tile uploads, reused so steady-state frames do not reallocate
+    QHash<QRgb, QVector<QLineF>> visibleLines;
+    QHash<QString, QVector<QPointF>> visibleSymbols;
+    QVector<float> vertexScratch;
+    QVector<QPoint> visibleTiles;
+
+    bool glReady = false;
+    bool glInstancing = false;
+    QOpenGLShaderProgram *lineProgram = nullptr;
+    QOpenGLShaderProgram *symbolProgram = nullptr;
+    QOpenGLBuffer quadBuffer;
+    QHash<QPoint, TileBuffers> tileBuffers;
+    bool tileBuffersStale = false;  // Set when the scene's batch changes
+    QHash<QString, QOpenGLTexture*> symbolTextures;
+};
+
+#endif // SCHEMATIC_VIEW_H
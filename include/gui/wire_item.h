@@ -2,11 +2,23 @@
 #define WIRE_ITEM_H
 
 #include <QGraphicsLineItem>
+#include <QPointer>
+
+class SchematicBatch;
 
 class WireItem : public QGraphicsLineItem {
 public:
     WireItem(QPointF start, QPointF end);
+    ~WireItem();
     void setEndPoint(QPointF end);
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override;
+
+protected:
+    QVariant itemChange(GraphicsItemChange change, const QVariant &value) override;
+
+private:
+    QPointer<SchematicBatch> batch;  // Batched renderer of the scene this wire is in
 };
 
 #endif // WIRE_ITEM_H
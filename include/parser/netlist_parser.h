@@ -0,0 +1,27 @@
+#ifndef CATHEDRAL_NETLIST_PARSER_H
+#define CATHEDRAL_NETLIST_PARSER_H
+
+#include <istream>
+#include <string>
+#include <vector>
+#include "core/circuit.h"
+
+namespace Cathedral {
+
+    // Two-terminal SPICE element lines ("R1 in out 1k"). Instance names are kept
+    // in CircuitComponent::id; Circuit assigns its own IDs when they are added.
+    // Node "0"/"gnd" is ground, numeric nodes keep their number and named nodes
+    // are numbered after the largest numeric node. As in SPICE the first line is
+    // the title unless `hasTitle` is false. Comments (*), continuation lines (+)
+    // and dot-cards are understood; parsing stops at .end, and .control/.endc and
+    // .subckt/.ends blocks are skipped along with X subcircuit instances.
+    bool ReadSpiceNetlist(std::istream& in, std::vector<CircuitComponent>& components, bool hasTitle = true);
+    bool ReadSpiceNetlistFile(const std::string& filename, std::vector<CircuitComponent>& components, bool hasTitle = true);
+
+    // Parses a SPICE number with optional scale suffix (f, p, n, u, m, k, meg, g, t).
+    // Always uses '.' as the decimal point, whatever the process locale.
+    bool ParseSpiceValue(const std::string& text, double& value);
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_NETLIST_PARSER_H
@@ -0,0 +1,19 @@
+#ifndef CATHEDRAL_VERILOG_READER_H
+#define CATHEDRAL_VERILOG_READER_H
+
+#include <istream>
+#include <string>
+#include "simulation/logic_sim.h"
+
+namespace Cathedral {
+
+    // Reads a flat, structural Verilog module built from gate primitives
+    // (and, nand, or, nor, xor, xnor, not, buf) with optional #delay. Ports may
+    // be declared in the body or in an ANSI header ("module m(input a, output y)").
+    // Returns false and logs the offending statement on unsupported input.
+    bool ReadStructuralVerilog(std::istream& in, LogicNetlist& netlist);
+    bool ReadStructuralVerilogFile(const std::string& filename, LogicNetlist& netlist);
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_VERILOG_READER_H
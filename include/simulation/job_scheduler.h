@@ -0,0 +1,209 @@
+#ifndef CATHEDRAL_JOB_SCHEDULER_H
+#define CATHEDRAL_JOB_SCHEDULER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "simulation/model_reduction.h"
+
+namespace Cathedral {
+
+    // Zero means unlimited. memoryBytes becomes RLIMIT_AS of an external
+    // simulator process; in-process backends can only honour the timeout.
+    struct JobLimits {
+        double timeoutSeconds = 0.0;
+        std::uint64_t memoryBytes = 0;
+    };
+
+    struct SimulationJob {
+        std::string name;
+        std::string netlist;  // SPICE text handed to the backend
+        int priority = 0;     // Higher runs first; equal priorities run in submission order
+        JobLimits limits;
+    };
+
+    enum class JobStatus { Queued, Running, Succeeded, Failed, TimedOut, Cancelled };
+    const char* JobStatusName(JobStatus status);
+
+    // Streamed to the scheduler's listener from worker threads. Finished is sent
+    // after the result is recorded, so stats() and takeResults() already include it.
+    struct JobEvent {
+        enum class Kind { Started, Output, Finished };
+        std::uint64_t jobId;
+        Kind kind;
+        JobStatus status;
+        std::string text;  // Output line, or the job name / error for Started and Finished
+    };
+
+    struct JobResult {
+        std::uint64_t id = 0;
+        std::string name;
+        JobStatus status = JobStatus::Queued;
+        std::string output;  // All streamed lines, newline-terminated
+        std::string error;
+        double queueSeconds = 0.0;
+        double runSeconds = 0.0;
+    };
+
+    // Handle a backend uses while running one job
+    class JobContext {
+    public:
+        void emit(const std::string& line);       // Streams one result line
+        void fail(const std::string& message);    // Sets the error text reported with the result
+        bool shouldStop() const;                  // Cancelled or past the deadline
+        JobStatus stopStatus() const;             // Cancelled or TimedOut, whichever applies
+        double remainingSeconds() const;          // Negative when there is no timeout
+        const JobLimits& limits() const { return jobLimits; }
+
+    private:
+        friend class JobScheduler;
+        using Clock = std::chrono::steady_clock;
+
+        JobContext(std::uint64_t id, const JobLimits& limits, const std::atomic<bool>& cancelled,
+                   const std::function<void(const JobEvent&)>& listener, JobResult& result);
+
+        std::uint64_t id;
+        JobLimits jobLimits;
+        const std::atomic<bool>& cancelled;
+        const std::function<void(const JobEvent&)>& listener;
+        JobResult& result;
+        Clock::time_point deadline;
+        bool hasDeadline;
+    };
+
+    class SimulationBackend {
+    public:
+        virtual ~SimulationBackend() = default;
+        virtual std::string name() const = 0;
+        // Called concurrently from several workers; returns the final status
+        virtual JobStatus run(const SimulationJob& job, JobContext& context) = 0;
+    };
+
+    class ResultCache;
+
+    // In-process solver: parses the netlist and reduces its linear subnetworks
+    // with PRIMA, emitting one line per reduced model. A subnetwork that cannot
+    // be reduced within targetError fails the job and is never cached. With a
+    // cache, each connected subcircuit is keyed separately, so an edited netlist
+    // only recomputes the parts that changed and the rest is served from disk.
+    class BuiltinBackend : public SimulationBackend {
+    public:
+        explicit BuiltinBackend(const PrimaOptions& options = PrimaOptions(),
+                                std::shared_ptr<ResultCache> cache = nullptr);
+        std::string name() const override { return "builtin"; }
+        JobStatus run(const SimulationJob& job, JobContext& context) override;
+
+    private:
+        PrimaOptions options;
+        std::string optionsText;  // Canonical form of `options` for cache keys
+        std::shared_ptr<ResultCache> cache;
+    };
+
+    // Runs an external simulator (ngspice, Xyce, or tools/fake_simulator) per
+    // job. Pipe protocol: the netlist is written to the child's stdin, unless an
+    // argument is "{netlist}", which is replaced by a temporary netlist file.
+    // Every stdout line is streamed as a result line; stderr becomes the error
+    // text. Exit status 0 means success. POSIX only.
+    class ExternalSimulatorBackend : public SimulationBackend {
+    public:
+        explicit ExternalSimulatorBackend(std::vector<std::string> command);
+        std::string name() const override;
+        JobStatus run(const SimulationJob& job, JobContext& context) override;
+
+    private:
+        std::vector<std::string> command;
+    };
+
+    struct SchedulerStats {
+        std::uint64_t submitted = 0;
+        std::uint64_t succeeded = 0;
+        std::uint64_t failed = 0;
+        std::uint64_t timedOut = 0;
+        std::uint64_t cancelled = 0;
+        double wallSeconds = 0.0;      // First submission to last completion
+        double busySeconds = 0.0;      // Summed backend run time
+        double queueSeconds = 0.0;     // Summed time jobs waited for a worker
+        double overheadSeconds = 0.0;  // Summed worker time spent dispatching and completing jobs, idle waits excluded
+
+        std::uint64_t completed() const { return succeeded + failed + timedOut + cancelled; }
+        double jobsPerSecond() const { return wallSeconds > 0.0 ? completed() / wallSeconds : 0.0; }
+        double overheadPerJobMicroseconds() const { return completed() ? overheadSeconds * 1e6 / completed() : 0.0; }
+    };
+
+    // Priority queue of simulation jobs drained by a fixed pool of workers. With
+    // the external backend each worker drives one simulator process at a time,
+    // so the pool size is also the number of concurrent processes.
+    class JobScheduler {
+    public:
+        using Listener = std::function<void(const JobEvent&)>;
+
+        explicit JobScheduler(std::shared_ptr<SimulationBackend> backend, int workers = 0);  // 0: one per hardware thread
+        ~JobScheduler();  // Cancels queued and running jobs, then joins the workers
+        JobScheduler(const JobScheduler&) = delete;
+        JobScheduler& operator=(const JobScheduler&) = delete;
+
+        void setListener(Listener listener);  // Set before submitting; invoked on worker threads
+        std::uint64_t submit(SimulationJob job);
+        bool cancel(std::uint64_t id);  // false if the job already finished or is unknown
+        void cancelAll();
+        void waitAll();
+
+        std::vector<JobResult> takeResults();  // Results finished since the last call
+        SchedulerStats stats() const;
+        void resetStats();  // Starts a new measurement window, e.g. per batch
+        int workerCount() const { return static_cast<int>(workers.size()); }
+        const SimulationBackend& getBackend() const { return *backend; }
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct JobState {
+            std::uint64_t id;
+            SimulationJob job;
+            std::atomic<bool> cancelled{false};
+            Clock::time_point submitted;
+        };
+
+        struct QueueEntry {
+            int priority;
+            std::uint64_t sequence;
+            std::shared_ptr<JobState> state;
+            bool operator<(const QueueEntry& other) const {
+                return priority != other.priority ? priority < other.priority : sequence > other.sequence;
+            }
+        };
+
+        void workerLoop();
+
+        std::shared_ptr<SimulationBackend> backend;
+        Listener listener;
+        std::vector<std::thread> workers;
+
+        mutable std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable allDone;
+        std::priority_queue<QueueEntry> queue;
+        std::unordered_map<std::uint64_t, std::shared_ptr<JobState>> active;  // Queued or running
+        std::vector<JobResult> results;
+        std::uint64_t nextId = 1;
+        int running = 0;
+        bool stopping = false;
+
+        SchedulerStats totals;
+        Clock::time_point firstSubmit;  // Of the current measurement window
+        Clock::time_point lastFinish;
+        bool windowOpen = false;
+    };
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_JOB_SCHEDULER_H
@@ -0,0 +1,165 @@
+#ifndef CATHEDRAL_LOGIC_SIM_H
+#define CATHEDRAL_LOGIC_SIM_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cathedral {
+
+    // Combinational gate primitives understood by the logic simulators
+    enum class GateType : std::uint8_t { BUF, NOT, AND, NAND, OR, NOR, XOR, XNOR };
+
+    struct LogicGate {
+        std::string name;
+        GateType type;
+        std::vector<int> inputs;  // Net indices
+        int output;               // Net index driven by this gate
+        double delay;             // Propagation delay used by the event-driven mode
+    };
+
+    // Gate-level netlist: named nets, primary I/O and the gates between them
+    class LogicNetlist {
+    public:
+        int addNet(const std::string& name);  // Returns the existing index if the net is known
+        int findNet(const std::string& name) const;  // -1 if unknown
+        void addInput(int net);
+        void addOutput(int net);
+        void addGate(const std::string& name, GateType type, const std::vector<int>& inputs, int output, double delay = 1.0);
+
+        int netCount() const { return static_cast<int>(netNames.size()); }
+        const std::string& netName(int net) const { return netNames[net]; }
+        const std::vector<int>& getInputs() const { return inputs; }
+        const std::vector<int>& getOutputs() const { return outputs; }
+        const std::vector<LogicGate>& getGates() const { return gates; }
+
+        // Topological order of gate indices; false (and logs) on a combinational loop
+        // or a net driven by more than one gate.
+        bool levelize(std::vector<int>& order, std::vector<int>& levels) const;
+
+    private:
+        std::vector<std::string> netNames;
+        std::unordered_map<std::string, int> netIndex;
+        std::vector<int> inputs;
+        std::vector<int> outputs;
+        std::vector<LogicGate> gates;
+    };
+
+    // Throughput counters shared by both simulation modes
+    struct LogicSimStats {
+        std::uint64_t gateEvaluations = 0;  // One per gate per pattern (or per event)
+        double seconds = 0.0;
+        double evaluationsPerSecond() const { return seconds > 0.0 ? gateEvaluations / seconds : 0.0; }
+    };
+
+    // One pattern bit per lane; a block is `blockWords` words wide so that
+    // each instruction is applied to 64 * blockWords patterns at once.
+    using PatternWord = std::uint64_t;
+
+    struct StuckAtFault {
+        int net;
+        bool stuckValue;
+    };
+
+    // Compiled-code simulator: the levelized netlist is flattened into a packed
+    // instruction array and evaluated with bitwise ops over pattern words.
+    class CompiledLogicSim {
+    public:
+        explicit CompiledLogicSim(const LogicNetlist& netlist, int blockWords = 1);
+
+        bool isCompiled() const { return compiled; }
+        int getBlockWords() const { return blockWords; }
+        int patternsPerBlock() const { return blockWords * 64; }
+
+        // inputs: blockWords words per primary input, in netlist input order.
+        // outputs: resized to blockWords words per primary output.
+        void simulate(const std::vector<PatternWord>& inputs, std::vector<PatternWord>& outputs);
+
+        // Single stuck-at fault simulation against one input block. detected[i]
+        // receives the blockWords-word mask of patterns that expose faults[i].
+        void simulateFaults(const std::vector<PatternWord>& inputs, const std::vector<StuckAtFault>& faults,
+                            std::vector<PatternWord>& detected);
+
+        // Both stuck-at faults on every net
+        static std::vector<StuckAtFault> allStuckAtFaults(const LogicNetlist& netlist);
+
+        const LogicSimStats& stats() const { return simStats; }
+        void resetStats() { simStats = LogicSimStats(); }
+
+    private:
+        struct Instruction {
+            GateType op;
+            std::uint8_t inputCount;
+            int output;
+            int firstOperand;  // Offset into operands
+        };
+
+        void loadInputs(const std::vector<PatternWord>& inputs, std::vector<PatternWord>& values) const;
+        void run(std::vector<PatternWord>& values, std::size_t first, int skipOutput) const;
+
+        int blockWords;
+        bool compiled = false;
+        int netTotal = 0;
+        std::vector<Instruction> program;
+        std::vector<int> operands;
+        std::vector<int> inputNets;
+        std::vector<int> outputNets;
+        std::vector<int> firstReader;  // Per net: first instruction that reads it (program.size() if none)
+        std::vector<PatternWord> goodValues;
+        std::vector<PatternWord> faultValues;
+        LogicSimStats simStats;
+    };
+
+    struct LogicTransition {
+        double time;
+        int net;
+        bool value;
+    };
+
+    // Event-driven timing simulator using per-gate transport delays
+    class EventLogicSim {
+    public:
+        explicit EventLogicSim(const LogicNetlist& netlist);
+
+        void setInput(int net, bool value, double time);
+        void run(double until);  // Processes all events up to and including `until`
+
+        bool value(int net) const { return values[net] != 0; }
+        double currentTime() const { return now; }
+        const std::vector<LogicTransition>& getTrace() const { return trace; }  // Primary output changes
+        void clearTrace() { trace.clear(); }
+
+        const LogicSimStats& stats() const { return simStats; }
+        void resetStats() { simStats = LogicSimStats(); }
+
+    private:
+        struct Event {
+            double time;
+            std::uint64_t sequence;  // Keeps same-time events in schedule order
+            int net;
+            std::uint8_t value;
+            bool operator>(const Event& other) const {
+                return time != other.time ? time > other.time : sequence > other.sequence;
+            }
+        };
+
+        void schedule(double time, int net, std::uint8_t value);
+        std::uint8_t evaluate(int gate) const;
+
+        std::vector<LogicGate> gates;
+        std::vector<int> fanoutStart;  // CSR fanout lists: gates reading each net
+        std::vector<int> fanoutGates;
+        std::vector<std::uint8_t> values;
+        std::vector<std::uint8_t> projected;  // Last value scheduled per gate output
+        std::vector<std::uint8_t> isOutput;
+        std::vector<Event> queue;  // Min-heap
+        std::uint64_t sequence = 0;
+        double now = 0.0;
+        std::vector<LogicTransition> trace;
+        LogicSimStats simStats;
+    };
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_LOGIC_SIM_H
@@ -0,0 +1,60 @@
+#ifndef CATHEDRAL_MODEL_REDUCTION_H
+#define CATHEDRAL_MODEL_REDUCTION_H
+
+#include <complex>
+#include <string>
+#include <vector>
+#include "core/circuit.h"
+
+namespace Cathedral {
+
+    struct PrimaOptions {
+        double expansionFrequency = 0.0;  // Hz; moments are matched about s0 = 2*pi*f
+        int maxBlockMoments = 16;         // Upper bound on Krylov blocks (order <= blocks * ports, and <= full order)
+        double targetError = 1e-3;        // Stop adding blocks once the check error is below this; models that never get there are rejected
+        std::vector<double> checkFrequencies = {1e3, 1e6, 1e8, 1e9, 1e10};  // Hz
+        int minInternalNodes = 16;        // Smaller linear subnetworks are left untouched
+        double gmin = 1e-12;              // Shunt conductance keeping floating nodes regular
+    };
+
+    // Reduced-order macromodel of a linear R/C/L subnetwork, seen from its ports:
+    //   (G + sC) x = B u,  y = B^T x
+    // with u the port current injections and y the port voltages.
+    struct ReducedModel {
+        std::vector<int> portNodes;
+        std::vector<std::string> componentIds;  // Components the macromodel replaces
+        int originalOrder = 0;                  // Unknowns of the full MNA system
+        int reducedOrder = 0;
+        std::vector<double> G, C, B;            // Row-major: q x q, q x q, q x ports
+        double maxRelativeError = -1.0;         // Over checkFrequencies; negative if not measured
+
+        // Port impedance matrix (ports x ports, row-major) at the given frequency in Hz
+        std::vector<std::complex<double>> impedance(double frequency) const;
+    };
+
+    // A linear subnetwork that should have been reduced but was not: the
+    // system could not be built or factored, or no model met targetError
+    struct ReductionFailure {
+        std::vector<std::string> componentIds;
+        double maxRelativeError = -1.0;  // Of the best model tried; negative if none was built
+    };
+
+    // Reduces every Resistor/Capacitor/Inductor of `circuit` to a macromodel seen
+    // from `portNodes` using PRIMA block Arnoldi projection. Node 0 is ground.
+    // Returns false (and logs) on failure, including when the model misses
+    // options.targetError; `model` then still holds the best attempt.
+    bool ReduceLinearNetwork(const Circuit& circuit, const std::vector<int>& portNodes,
+                             const PrimaOptions& options, ReducedModel& model);
+
+    // Splits the linear components into connected subnetworks, keeps as ports
+    // every node shared with a non-linear component or listed in `externalNodes`,
+    // and reduces each subnetwork with at least options.minInternalNodes internal nodes.
+    // Only models within options.targetError are returned; subnetworks that
+    // could not be reduced to spec are appended to `failures` when given.
+    std::vector<ReducedModel> ReduceLinearSubnetworks(const Circuit& circuit, const std::vector<int>& externalNodes,
+                                                      const PrimaOptions& options = PrimaOptions(),
+                                                      std::vector<ReductionFailure>* failures = nullptr);
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_MODEL_REDUCTION_H
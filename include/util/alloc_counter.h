@@ -0,0 +1,43 @@
+#ifndef CATHEDRAL_ALLOC_COUNTER_H
+#define CATHEDRAL_ALLOC_COUNTER_H
+
+#include <cstdint>
+
+namespace Cathedral {
+
+    // Number of global operator new calls made by the calling thread. Only
+    // counted when built with CATHEDRAL_COUNT_ALLOCATIONS; otherwise always 0.
+    std::uint64_t ThreadAllocationCount();
+    bool AllocationCountingEnabled();
+
+    // Logs the offending loop and aborts; used by SteadyStateCheck
+    [[noreturn]] void ReportSteadyStateAllocation(const char* loop, std::uint64_t allocations);
+
+    // Scoped marker for one steady-state iteration of a hot loop. In counting
+    // builds it aborts if the iteration reached the global heap; in normal
+    // builds it compiles to nothing.
+#ifdef CATHEDRAL_COUNT_ALLOCATIONS
+    class SteadyStateCheck {
+    public:
+        explicit SteadyStateCheck(const char* loop) : loop(loop), start(ThreadAllocationCount()) {}
+        ~SteadyStateCheck() {
+            std::uint64_t allocations = ThreadAllocationCount() - start;
+            if (allocations != 0) ReportSteadyStateAllocation(loop, allocations);
+        }
+        SteadyStateCheck(const SteadyStateCheck&) = delete;
+        SteadyStateCheck& operator=(const SteadyStateCheck&) = delete;
+
+    private:
+        const char* loop;
+        std::uint64_t start;
+    };
+#else
+    class SteadyStateCheck {
+    public:
+        explicit SteadyStateCheck(const char*) {}
+    };
+#endif
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_ALLOC_COUNTER_H
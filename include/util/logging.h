@@ -3,6 +3,8 @@
 
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <mutex>
 #include <string>
 
 namespace Cathedral {
@@ -10,11 +12,18 @@ namespace Cathedral {
 
     class Logger {
     public:
+        using Sink = std::function<void(const std::string& message, LogLevel level)>;
+
         static void Log(const std::string& message, LogLevel level = LogLevel::INFO);
         static void SetLogFile(const std::string& filename);
+        static void SetSink(Sink sink);  // Extra destination such as the GUI console; must not log back through Logger
+        static void SetConsoleLevel(LogLevel minimum);  // Quieter stdout, e.g. for benchmarks; file and sink get everything
 
     private:
         static std::ofstream logFile;
+        static Sink sink;
+        static LogLevel consoleLevel;
+        static std::mutex mutex;
         static std::string LogLevelToString(LogLevel level);
     };
 }
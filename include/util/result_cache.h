@@ -0,0 +1,52 @@
+#ifndef CATHEDRAL_RESULT_CACHE_H
+#define CATHEDRAL_RESULT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include "core/circuit_hash.h"
+
+namespace Cathedral {
+
+    // Content-addressed store of simulation results on disk. Entries live in
+    // <directory>/<first two hex digits>/<key>.result; lookups refresh the file
+    // time so eviction drops the least recently used entries first. Safe to share
+    // between threads, and between processes using the same directory.
+    //
+    // `keyText` is the CircuitKeyText the key was hashed from. It is stored in
+    // the entry header and compared on lookup, so a hash collision or a file left
+    // by another build is a miss rather than a wrong result.
+    class ResultCache {
+    public:
+        explicit ResultCache(const std::string& directory, std::uintmax_t maxBytes = 1ULL << 30);
+
+        bool lookup(const CircuitKey& key, const std::string& keyText, std::string& result);
+        bool store(const CircuitKey& key, const std::string& keyText, const std::string& result);
+        void clear();  // Removes the cache entries only, not other files in the directory
+
+        // Serves `key` from disk or runs `compute` and stores its result
+        std::string getOrCompute(const CircuitKey& key, const std::string& keyText,
+                                 const std::function<std::string()>& compute);
+
+        std::uintmax_t sizeBytes() const;
+        std::uintmax_t getMaxBytes() const { return maxBytes; }
+        std::uint64_t getHits() const { return hits; }
+        std::uint64_t getMisses() const { return misses; }
+
+    private:
+        std::string pathFor(const CircuitKey& key) const;
+        void evictToLimit();
+
+        std::string directory;
+        std::uintmax_t maxBytes;
+        std::uintmax_t totalBytes = 0;
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        mutable std::mutex mutex;  // Guards totalBytes and eviction; entry I/O happens outside it
+    };
+
+} // namespace Cathedral
+
+#endif // CATHEDRAL_RESULT_CACHE_H
@@ -0,0 +1,133 @@
+#include "core/arena.h"
+#include <algorithm>
+
+namespace Cathedral {
+
+    namespace {
+        constexpr std::size_t kChunkHeader = (sizeof(void*) + sizeof(std::size_t) + alignof(std::max_align_t) - 1)
+                                           / alignof(std::max_align_t) * alignof(std::max_align_t);
+
+        std::size_t roundUp(std::size_t value, std::size_t alignment) {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+    }
+
+    MonotonicArena::MonotonicArena(std::size_t initialBytes) {
+        if (initialBytes > 0) {
+            addChunk(initialBytes);
+        }
+    }
+
+    MonotonicArena::~MonotonicArena() {
+        releaseChunks();
+    }
+
+    void MonotonicArena::addChunk(std::size_t minBytes) {
+        // Geometric growth keeps the number of chunks per cycle logarithmic
+        std::size_t size = std::max(minBytes, head ? head->size * 2 : minBytes);
+        char* memory = static_cast<char*>(::operator new(kChunkHeader + size));
+        Chunk* chunk = reinterpret_cast<Chunk*>(memory);
+        chunk->next = head;
+        chunk->size = size;
+        head = chunk;
+        cursor = memory + kChunkHeader;
+        end = cursor + size;
+        totalCapacity += size;
+        ++chunksAllocated;
+    }
+
+    void MonotonicArena::releaseChunks() {
+        while (head) {
+            Chunk* next = head->next;
+            ::operator delete(head);
+            head = next;
+        }
+        cursor = end = nullptr;
+        totalCapacity = 0;
+    }
+
+    void* MonotonicArena::allocate(std::size_t bytes, std::size_t alignment) {
+        std::uintptr_t address = reinterpret_cast<std::uintptr_t>(cursor);
+        std::uintptr_t aligned = roundUp(address, alignment);
+        if (!head || aligned + bytes > reinterpret_cast<std::uintptr_t>(end)) {
+            addChunk(bytes + alignment);
+            address = reinterpret_cast<std::uintptr_t>(cursor);
+            aligned = roundUp(address, alignment);
+        }
+        cursor = reinterpret_cast<char*>(aligned + bytes);
+        used += bytes + (aligned - address);
+        peak = std::max(peak, used);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    void MonotonicArena::reset() {
+        if (head && head->next) {
+            // One chunk big enough for everything the cycle needed
+            std::size_t total = totalCapacity;
+            releaseChunks();
+            addChunk(total);
+        } else if (head) {
+            cursor = reinterpret_cast<char*>(head) + kChunkHeader;
+        }
+        used = 0;
+    }
+
+    BlockPool::BlockPool(std::size_t blockBytes, std::size_t blocksPerSlab)
+        : blockBytes(roundUp(std::max(blockBytes, sizeof(FreeBlock)), kBlockAlignment)),
+          blocksPerSlab(std::max<std::size_t>(blocksPerSlab, 1)) {}
+
+    BlockPool::~BlockPool() {
+        for (void* slab : slabs) {
+            ::operator delete(slab, std::align_val_t(kBlockAlignment));
+        }
+    }
+
+    void BlockPool::addSlab(std::size_t blocks) {
+        char* slab = static_cast<char*>(::operator new(blocks * blockBytes, std::align_val_t(kBlockAlignment)));
+        slabs.push_back(slab);
+        // Thread the new blocks onto the free list in address order
+        for (std::size_t i = blocks; i-- > 0;) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * blockBytes);
+            block->next = freeList;
+            freeList = block;
+        }
+        freeCount += blocks;
+        totalBlocks += blocks;
+    }
+
+    void* BlockPool::allocate() {
+        if (!freeList) {
+            addSlab(blocksPerSlab);
+        }
+        FreeBlock* block = freeList;
+        freeList = block->next;
+        --freeCount;
+        ++inUse;
+        return block;
+    }
+
+    void BlockPool::deallocate(void* block) {
+        if (!block) return;
+        FreeBlock* freed = static_cast<FreeBlock*>(block);
+        freed->next = freeList;
+        freeList = freed;
+        ++freeCount;
+        --inUse;
+    }
+
+    void BlockPool::reserve(std::size_t blocks) {
+        if (blocks > freeCount) {
+            addSlab(blocks - freeCount);
+        }
+    }
+
+    BlockPool& AnalysisMemory::pool(std::size_t blockBytes) {
+        const std::size_t size = roundUp(std::max(blockBytes, sizeof(void*)), BlockPool::kBlockAlignment);
+        for (const auto& existing : pools) {
+            if (existing->blockSize() == size) return *existing;
+        }
+        pools.push_back(std::make_unique<BlockPool>(size));
+        return *pools.back();
+    }
+
+} // namespace Cathedral
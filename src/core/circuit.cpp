@@ -13,6 +13,19 @@ namespace Cathedral {
         std::cout << "Added component: " << id << " (" << type << ")" << std::endl;
     }
 
+    std::vector<std::string> Circuit::addComponents(const std::vector<CircuitComponent>& parts) {
+        // Silent: importers and simulation jobs call this per netlist and report their own summary
+        std::vector<std::string> ids;
+        ids.reserve(parts.size());
+        components.reserve(components.size() + parts.size());
+        for (const CircuitComponent& part : parts) {
+            std::string id = part.type + std::to_string(componentCounter++);
+            components[id] = {id, part.type, part.value, part.node1, part.node2};
+            ids.push_back(std::move(id));
+        }
+        return ids;
+    }
+
     void Circuit::removeComponent(const std::string& id) {
         if (components.erase(id)) {
             std::cout << "Removed component: " << id << std::endl;
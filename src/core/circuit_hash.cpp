@@ -0,0 +1,157 @@
+#include "core/circuit_hash.h"
+#include <algorithm>
+#include <cstdio>
+#include <locale>
+#include <map>
+#include <sstream>
+
+namespace Cathedral {
+
+    namespace {
+        // Two FNV-1a streams with different offset bases give a 128-bit key
+        const std::uint64_t kFnvPrime = 1099511628211ULL;
+        const std::uint64_t kOffsetHigh = 14695981039346656037ULL;
+        const std::uint64_t kOffsetLow = 0x6c62272e07bb0142ULL;
+
+        // Bump whenever the canonical form or the cached result format changes,
+        // so stale entries written by older builds can never be matched
+        const char* kKeyFormat = "cathedral-key 3";
+
+        CircuitKey hashText(const std::string& text) {
+            CircuitKey key{kOffsetHigh, kOffsetLow};
+            for (unsigned char c : text) {
+                key.high = (key.high ^ c) * kFnvPrime;
+                key.low = (key.low ^ static_cast<unsigned char>(c + 0x5b)) * kFnvPrime;
+                key.low ^= key.low >> 29;
+            }
+            return key;
+        }
+
+        bool isSymmetric(const std::string& type) {
+            return type == "Resistor" || type == "Capacitor" || type == "Inductor";
+        }
+
+        // Nodes are written as their rank among `nodes` (sorted, ground excluded),
+        // not their number. Adding a part elsewhere in the netlist shifts node
+        // numbers but keeps their order, so the keys of untouched groups survive.
+        int nodeLabel(const std::vector<int>& nodes, int node) {
+            if (node == 0) return 0;
+            return static_cast<int>(std::lower_bound(nodes.begin(), nodes.end(), node) - nodes.begin()) + 1;
+        }
+
+        std::string canonicalLine(const CircuitComponent& component, const std::vector<int>& nodes) {
+            int a = nodeLabel(nodes, component.node1), b = nodeLabel(nodes, component.node2);
+            if (isSymmetric(component.type) && b < a) {
+                std::swap(a, b);
+            }
+            // Exact hex float, with a '.' radix whatever the process locale is
+            std::ostringstream line;
+            line.imbue(std::locale::classic());
+            line << component.type << ' ' << std::hexfloat << component.value << ' ' << a << ' ' << b;
+            return line.str();
+        }
+
+        std::string joinSorted(std::vector<std::string>& lines) {
+            std::sort(lines.begin(), lines.end());
+            std::string text;
+            for (const std::string& line : lines) {
+                text += line;
+                text += '\n';
+            }
+            return text;
+        }
+
+    }
+
+    std::string CircuitKeyText(const std::string& canonical, const std::string& analysisOptions) {
+        return std::string(kKeyFormat) + "\n" + canonical + ".options " + analysisOptions + "\n";
+    }
+
+    std::string CircuitKey::toHex() const {
+        char text[33];
+        std::snprintf(text, sizeof(text), "%016llx%016llx", static_cast<unsigned long long>(high),
+                      static_cast<unsigned long long>(low));
+        return text;
+    }
+
+    std::string CanonicalizeCircuit(const Circuit& circuit) {
+        std::vector<int> nodes;
+        for (const auto& [id, component] : circuit.getComponents()) {
+            for (int node : {component.node1, component.node2}) {
+                if (node != 0) nodes.push_back(node);
+            }
+        }
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+
+        std::vector<std::string> lines;
+        lines.reserve(circuit.getComponents().size());
+        for (const auto& [id, component] : circuit.getComponents()) {
+            lines.push_back(canonicalLine(component, nodes));
+        }
+        return joinSorted(lines);
+    }
+
+    CircuitKey HashCircuit(const Circuit& circuit, const std::string& analysisOptions) {
+        return hashText(CircuitKeyText(CanonicalizeCircuit(circuit), analysisOptions));
+    }
+
+    std::vector<SubcircuitKey> HashSubcircuits(const Circuit& circuit, const std::string& analysisOptions) {
+        std::map<int, int> parent;
+        auto find = [&](int node) {
+            int root = node;
+            while (parent[root] != root) root = parent[root];
+            while (parent[node] != root) { int up = parent[node]; parent[node] = root; node = up; }
+            return root;
+        };
+
+        for (const auto& [id, component] : circuit.getComponents()) {
+            for (int node : {component.node1, component.node2}) {
+                if (node != 0) parent.emplace(node, node);
+            }
+            if (component.node1 != 0 && component.node2 != 0) {
+                parent[find(component.node1)] = find(component.node2);
+            }
+        }
+
+        // Components with both terminals on ground share one group
+        std::map<int, std::vector<const CircuitComponent*>> groups;
+        std::vector<const CircuitComponent*> grounded;
+        for (const auto& [id, component] : circuit.getComponents()) {
+            if (component.node1 == 0 && component.node2 == 0) {
+                grounded.push_back(&component);
+            } else {
+                groups[find(component.node1 != 0 ? component.node1 : component.node2)].push_back(&component);
+            }
+        }
+
+        std::vector<SubcircuitKey> subcircuits;
+        auto addGroup = [&](std::vector<const CircuitComponent*>& parts) {
+            SubcircuitKey sub;
+            for (const CircuitComponent* part : parts) {
+                sub.componentIds.push_back(part->id);
+                for (int node : {part->node1, part->node2}) {
+                    if (node != 0) sub.nodes.push_back(node);
+                }
+            }
+            std::sort(sub.componentIds.begin(), sub.componentIds.end());
+            std::sort(sub.nodes.begin(), sub.nodes.end());
+            sub.nodes.erase(std::unique(sub.nodes.begin(), sub.nodes.end()), sub.nodes.end());
+            std::vector<std::string> lines;
+            for (const CircuitComponent* part : parts) {
+                lines.push_back(canonicalLine(*part, sub.nodes));
+            }
+            sub.canonical = joinSorted(lines);
+            sub.key = hashText(CircuitKeyText(sub.canonical, analysisOptions));
+            subcircuits.push_back(std::move(sub));
+        };
+        for (auto& [root, parts] : groups) {
+            addGroup(parts);
+        }
+        if (!grounded.empty()) {
+            addGroup(grounded);
+        }
+        return subcircuits;
+    }
+
+} // namespace Cathedral
@@ -2,6 +2,7 @@
 #include <QPainter>
 #include <QGraphicsSceneMouseEvent>
 #include "gui/main_window.h"
+#include "gui/schematic_batch.h"
 #include <QDebug>
 #include <cmath>
 
@@ -11,15 +12,35 @@ ComponentItem::ComponentItem(const QString& type, int x, int y)
       componentType(type),
       isDragging(false) {
     setPos(x, y);
-    setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable);
+    setFlags(QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemIsSelectable | QGraphicsItem::ItemSendsGeometryChanges);
     initializeTerminals();  // Set up terminals
 }
 
+ComponentItem::~ComponentItem() {
+    // ~QGraphicsItem removes us from the scene without calling itemChange()
+    if (batch) batch->removeSymbol(this);
+}
+
+QVariant ComponentItem::itemChange(GraphicsItemChange change, const QVariant &value) {
+    if (change == ItemSceneChange && batch) {
+        batch->removeSymbol(this);
+        batch = nullptr;
+    } else if (change == ItemSceneHasChanged && scene()) {
+        batch = SchematicBatch::forScene(scene());
+        batch->addSymbol(this, componentType, pos());
+    } else if (change == ItemPositionHasChanged && batch) {
+        batch->addSymbol(this, componentType, pos());
+    } else if (change == ItemSelectedHasChanged && batch) {
+        batch->itemSelectionChanged(this);
+    }
+    return QGraphicsItem::itemChange(change, value);
+}
+
 QRectF ComponentItem::boundingRect() const {
     return QRectF(-15, -10, 30, 20);
 }
 
-void ComponentItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+void ComponentItem::paintSymbol(QPainter *painter, const QString& componentType) {
     painter->setRenderHint(QPainter::Antialiasing);
 
     QColor fillColor, borderColor;
@@ -29,6 +50,9 @@ void ComponentItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, Q
     } else if (componentType == "Capacitor") {
         fillColor = QColor("#00AFFF");
         borderColor = QColor("#0088CC");
+    } else if (componentType == "Inductor") {
+        fillColor = QColor("#B266FF");
+        borderColor = QColor("#8A2BE2");
     } else {
         fillColor = Qt::white;
         borderColor = Qt::black;
@@ -46,27 +70,37 @@ void ComponentItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, Q
         painter->drawLine(10, -5, 10, 5);    // Right plate
         painter->drawLine(-15, 0, -10, 0);   // Left terminal line
         painter->drawLine(10, 0, 15, 0);     // Right terminal line
+    } else {
+        // Imported parts without a dedicated symbol (inductors, sources, ...)
+        painter->drawRoundedRect(-10, -6, 20, 12, 3, 3);
+        painter->drawLine(-15, 0, -10, 0);
+        painter->drawLine(10, 0, 15, 0);
     }
 
     // Draw terminal markers (for visualization)
     painter->setPen(QPen(Qt::red, 2));
-    for (const QPointF& terminal : terminals) {
-        painter->drawEllipse(terminal.x() - 2, terminal.y() - 2, 4, 4);
+    painter->drawEllipse(-17, -2, 4, 4);
+    painter->drawEllipse(13, -2, 4, 4);
+}
+
+void ComponentItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+    // With instanced symbols the view has already drawn the body; only selection is per item
+    if (!batch || !batch->symbolsBatched()) {
+        paintSymbol(painter, componentType);
     }
 
     if (isSelected()) {
         painter->setPen(QPen(QColor("#00FFFF"), 3));
+        painter->setBrush(Qt::NoBrush);
         painter->drawRect(boundingRect());
     }
 }
 
 void ComponentItem::initializeTerminals() {
     terminals.clear();
-    if (componentType == "Resistor" || componentType == "Capacitor") {
-        // Add terminals at left and right sides (relative to center)
-        terminals.append(QPointF(-15, 0));  // Left terminal
-        terminals.append(QPointF(15, 0));   // Right terminal
-    }
+    // Every supported part is two-terminal: left and right sides (relative to center)
+    terminals.append(QPointF(-15, 0));  // Left terminal
+    terminals.append(QPointF(15, 0));   // Right terminal
 }
 
 QPointF ComponentItem::getNearestTerminal(const QPointF& clickPos) const {
@@ -107,7 +141,6 @@ void ComponentItem::mousePressEvent(QGraphicsSceneMouseEvent *event) {
 void ComponentItem::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
     MainWindow* mainWin = qobject_cast<MainWindow*>(scene()->views().first()->parentWidget());
     if (!mainWin || mainWin->isWireModeEnabled()) {
-        qDebug() << "Wire mode active, ignoring drag on" << componentType;
         event->accept();
         return;
     }
@@ -116,7 +149,6 @@ void ComponentItem::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
         QPointF delta = event->scenePos() - lastPosition;
         setPos(pos() + delta);
         lastPosition = event->scenePos();
-        qDebug() << "Dragging" << componentType << "to" << pos();
         emit positionChanged(this);
     }
     QGraphicsItem::mouseMoveEvent(event);
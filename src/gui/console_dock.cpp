@@ -0,0 +1,259 @@
+#include "gui/console_dock.h"
+#include <QAction>
+#include <QBrush>
+#include <QColor>
+#include <QListView>
+#include <QMenu>
+#include <QMutexLocker>
+#include <QPointer>
+#include <QScrollBar>
+#include <QTimer>
+#include <QToolButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+namespace {
+    const int flushIntervalMs = 50;
+
+    QPointer<ConsoleDock> messageTarget;
+    QtMessageHandler previousHandler = nullptr;
+
+    void consoleMessageHandler(QtMsgType type, const QMessageLogContext &context, const QString &message) {
+        QString category;
+        switch (type) {
+            case QtDebugMsg: category = "Debug"; break;
+            case QtInfoMsg: category = "Info"; break;
+            case QtWarningMsg: category = "Warning"; break;
+            default: category = "Error"; break;
+        }
+        if (messageTarget) {
+            messageTarget->append(message, category);
+        }
+        // Only warnings and worse still reach stderr; debug chatter stays in the console
+        if (previousHandler && type != QtDebugMsg && type != QtInfoMsg) {
+            previousHandler(type, context, message);
+        }
+    }
+}
+
+ConsoleModel::ConsoleModel(int lineCap, QObject *parent)
+    : QAbstractListModel(parent), ring(qMax(1, lineCap)), capacity(qMax(1, lineCap)) {}
+
+int ConsoleModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : count;
+}
+
+QVariant ConsoleModel::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= count) return QVariant();
+    const ConsoleEntry &entry = at(index.row());
+
+    switch (role) {
+        case Qt::DisplayRole:
+            return entry.text;
+        case Qt::ToolTipRole:
+        case CategoryRole:
+            return entry.category;
+        case Qt::ForegroundRole:
+            if (entry.category == "Error") return QBrush(QColor("#FF5555"));
+            if (entry.category == "Warning") return QBrush(QColor("#FFA500"));
+            if (entry.category == "Debug") return QBrush(QColor("#888888"));
+            return QVariant();
+        default:
+            return QVariant();
+    }
+}
+
+void ConsoleModel::appendBatch(const QVector<ConsoleEntry> &batch) {
+    const int incoming = batch.size();
+    if (incoming == 0) return;
+
+    if (incoming >= capacity) {
+        // The batch alone fills the buffer: keep its newest lines and reset once
+        beginResetModel();
+        for (int i = 0; i < capacity; ++i) {
+            ring[i] = batch[incoming - capacity + i];
+        }
+        head = 0;
+        count = capacity;
+        endResetModel();
+        return;
+    }
+
+    const int overflow = count + incoming - capacity;
+    if (overflow > 0) {
+        beginRemoveRows(QModelIndex(), 0, overflow - 1);
+        for (int i = 0; i < overflow; ++i) {
+            ring[(head + i) % capacity] = ConsoleEntry();
+        }
+        head = (head + overflow) % capacity;
+        count -= overflow;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), count, count + incoming - 1);
+    for (const ConsoleEntry &entry : batch) {
+        ring[(head + count) % capacity] = entry;
+        ++count;
+    }
+    endInsertRows();
+}
+
+void ConsoleModel::clear() {
+    beginResetModel();
+    ring.fill(ConsoleEntry());
+    head = 0;
+    count = 0;
+    endResetModel();
+}
+
+void ConsoleFilterModel::setCategoryVisible(const QString &category, bool visible) {
+    if (visible) {
+        hiddenCategories.remove(category);
+    } else {
+        hiddenCategories.insert(category);
+    }
+    invalidateFilter();
+}
+
+bool ConsoleFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const {
+    if (hiddenCategories.isEmpty()) return true;
+    QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
+    return !hiddenCategories.contains(index.data(ConsoleModel::CategoryRole).toString());
+}
+
+ConsoleDock::ConsoleDock(const QString &title, QWidget *parent, int lineCap)
+    : QDockWidget(title, parent) {
+    model = new ConsoleModel(lineCap, this);
+    filter = new ConsoleFilterModel(this);
+    filter->setSourceModel(model);
+
+    // Uniform row heights let the view lay out only the visible lines
+    view = new QListView();
+    view->setUniformItemSizes(true);
+    view->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    view->setModel(model);
+
+    filterMenu = new QMenu(this);
+    QToolButton *filterButton = new QToolButton();
+    filterButton->setText("Categories");
+    filterButton->setMenu(filterMenu);
+    filterButton->setPopupMode(QToolButton::InstantPopup);
+
+    QToolButton *clearButton = new QToolButton();
+    clearButton->setText("Clear");
+    connect(clearButton, &QToolButton::clicked, this, &ConsoleDock::clear);
+
+    QHBoxLayout *controls = new QHBoxLayout();
+    controls->setContentsMargins(0, 0, 0, 0);
+    controls->addWidget(filterButton);
+    controls->addWidget(clearButton);
+    controls->addStretch();
+
+    QWidget *container = new QWidget();
+    QVBoxLayout *layout = new QVBoxLayout(container);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addLayout(controls);
+    layout->addWidget(view);
+    setWidget(container);
+
+    flushTimer = new QTimer(this);
+    flushTimer->setSingleShot(true);
+    flushTimer->setInterval(flushIntervalMs);
+    connect(flushTimer, &QTimer::timeout, this, &ConsoleDock::flushPending);
+}
+
+ConsoleDock::~ConsoleDock() {
+    if (messageTarget == this) {
+        qInstallMessageHandler(previousHandler);
+        messageTarget = nullptr;
+    }
+}
+
+void ConsoleDock::installMessageHandler() {
+    messageTarget = this;
+    QtMessageHandler previous = qInstallMessageHandler(consoleMessageHandler);
+    if (previous != consoleMessageHandler) {
+        previousHandler = previous;
+    }
+}
+
+void ConsoleDock::append(const QString &text, const QString &category) {
+    bool wasEmpty;
+    {
+        QMutexLocker locker(&pendingMutex);
+        wasEmpty = pending.isEmpty();
+        if (pending.size() >= model->lineCap()) {
+            // Bound the queue by the line cap too; drop the oldest half at once
+            const int drop = pending.size() / 2;
+            pending.remove(0, drop);
+            droppedMessages += drop;
+        }
+        pending.append(ConsoleEntry{category, text});
+    }
+    if (wasEmpty) {
+        // Timers belong to the GUI thread, so start the flush from there
+        QMetaObject::invokeMethod(this, [this]() {
+            if (!flushTimer->isActive()) flushTimer->start();
+        }, Qt::QueuedConnection);
+    }
+}
+
+void ConsoleDock::flushPending() {
+    QVector<ConsoleEntry> batch;
+    int dropped;
+    {
+        QMutexLocker locker(&pendingMutex);
+        batch.swap(pending);
+        dropped = droppedMessages;
+        droppedMessages = 0;
+    }
+    if (dropped > 0) {
+        batch.prepend(ConsoleEntry{"Warning", QString("... %1 messages dropped").arg(dropped)});
+    }
+    if (batch.isEmpty()) return;
+
+    for (const ConsoleEntry &entry : batch) {
+        if (!knownCategories.contains(entry.category)) {
+            registerCategory(entry.category);
+        }
+    }
+
+    QScrollBar *scrollBar = view->verticalScrollBar();
+    const bool followTail = scrollBar->value() == scrollBar->maximum();
+    model->appendBatch(batch);
+    if (followTail) {
+        view->scrollToBottom();
+    }
+}
+
+void ConsoleDock::registerCategory(const QString &category) {
+    knownCategories.insert(category);
+    QAction *action = filterMenu->addAction(category);
+    action->setCheckable(true);
+    action->setChecked(true);
+    connect(action, &QAction::toggled, this, [this, category](bool checked) {
+        setCategoryVisible(category, checked);
+    });
+}
+
+void ConsoleDock::setCategoryVisible(const QString &category, bool visible) {
+    filter->setCategoryVisible(category, visible);
+    // Bypass the proxy entirely while nothing is filtered
+    QAbstractItemModel *wanted = filter->hasHiddenCategories() ? static_cast<QAbstractItemModel*>(filter)
+                                                               : static_cast<QAbstractItemModel*>(model);
+    if (view->model() != wanted) {
+        view->setModel(wanted);
+        view->scrollToBottom();
+    }
+}
+
+void ConsoleDock::clear() {
+    {
+        QMutexLocker locker(&pendingMutex);
+        pending.clear();
+        droppedMessages = 0;
+    }
+    model->clear();
+}
@@ -1,15 +1,25 @@
 #include "gui/main_window.h"
 #include "gui/component_item.h"
 #include "gui/wire_item.h"
+#include "gui/console_dock.h"
+#include "simulation/job_scheduler.h"
+#include "util/logging.h"
+#include "util/result_cache.h"
 #include <QMenuBar>
 #include <QToolBar>
 #include <QDockWidget>
 #include <QGraphicsScene>
-#include <QTextEdit>
 #include <QAction>
 #include <QMouseEvent>
 #include <QKeyEvent>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QFileDialog>
+#include <QFile>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent), componentX(0) {
@@ -20,32 +30,32 @@ MainWindow::MainWindow(QWidget *parent)
     createToolBar();
     createDockWidgets();
 
-    schematicView = new QGraphicsView(this);
+    // The grid is drawn by SchematicView::drawBackground, not as scene items
+    schematicView = new SchematicView(this);
     scene = new QGraphicsScene(this);
     scene->setBackgroundBrush(QColor("#1E1E1E"));
 
-    const int gridSize = 20;
-    for (int x = -500; x <= 500; x += gridSize) {
-        scene->addLine(x, -500, x, 500, QPen(QColor("#444444")));
-    }
-    for (int y = -500; y <= 500; y += gridSize) {
-        scene->addLine(-500, y, 500, y, QPen(QColor("#444444")));
-    }
-
     schematicView->setScene(scene);
     schematicView->setDragMode(QGraphicsView::RubberBandDrag);
     setCentralWidget(schematicView);
 }
 
-MainWindow::~MainWindow() {}
+MainWindow::~MainWindow() {
+    scheduler.reset();  // Joins the workers while the console they stream to still exists
+    Cathedral::Logger::SetSink(nullptr);
+}
 
 void MainWindow::createMenuBar() {
     QMenuBar *menuBar = new QMenuBar(this);
     setMenuBar(menuBar);
 
     QMenu *fileMenu = menuBar->addMenu("&File");
+    QAction *importNetlistAction = new QAction("Import Netlist...", this);
     QAction *exitAction = new QAction("Exit", this);
+    fileMenu->addAction(importNetlistAction);
+    fileMenu->addSeparator();
     fileMenu->addAction(exitAction);
+    connect(importNetlistAction, &QAction::triggered, this, &MainWindow::importNetlist);
     connect(exitAction, &QAction::triggered, this, &MainWindow::close);
 
     QMenu *circuitMenu = menuBar->addMenu("&Circuit");
@@ -60,6 +70,20 @@ void MainWindow::createMenuBar() {
     connect(addResistorAction, &QAction::triggered, this, &MainWindow::addResistor);
     connect(addCapacitorAction, &QAction::triggered, this, &MainWindow::addCapacitor);
     connect(listCircuitAction, &QAction::triggered, this, &MainWindow::listCircuit);
+
+    QMenu *simulationMenu = menuBar->addMenu("&Simulation");
+    QAction *runNetlistBatchAction = new QAction("Run Netlist Batch...", this);
+    QAction *cancelSimulationsAction = new QAction("Cancel Simulations", this);
+    simulationMenu->addAction(runNetlistBatchAction);
+    simulationMenu->addAction(cancelSimulationsAction);
+    connect(runNetlistBatchAction, &QAction::triggered, this, &MainWindow::runNetlistBatch);
+    connect(cancelSimulationsAction, &QAction::triggered, this, &MainWindow::cancelSimulations);
+
+    QMenu *viewMenu = menuBar->addMenu("&View");
+    QAction *openGLViewportAction = new QAction("OpenGL Viewport", this);
+    openGLViewportAction->setCheckable(true);
+    viewMenu->addAction(openGLViewportAction);
+    connect(openGLViewportAction, &QAction::toggled, this, &MainWindow::toggleOpenGLViewport);
 }
 
 void MainWindow::createToolBar() {
@@ -84,16 +108,22 @@ void MainWindow::createToolBar() {
 }
 
 void MainWindow::createDockWidgets() {
-    QDockWidget *logDock = new QDockWidget("Console", this);
-    logConsole = new QTextEdit();
-    logConsole->setReadOnly(true);
-    logDock->setWidget(logConsole);
-    addDockWidget(Qt::BottomDockWidgetArea, logDock);
+    logConsole = new ConsoleDock("Console", this);
+    addDockWidget(Qt::BottomDockWidgetArea, logConsole);
+    logConsole->installMessageHandler();
+
+    // Core code logs from worker threads; the console queues and batches it
+    ConsoleDock *console = logConsole;
+    Cathedral::Logger::SetSink([console](const std::string& message, Cathedral::LogLevel level) {
+        QString category = level == Cathedral::LogLevel::ERROR ? "Error"
+                         : level == Cathedral::LogLevel::WARNING ? "Warning" : "Core";
+        console->append(QString::fromStdString(message), category);
+    });
 }
 
 void MainWindow::addResistor() {
     circuit.addComponent("Resistor", 1000, 1, 2);
-    logConsole->append("Added Resistor (1kΩ) between nodes 1 and 2.");
+    logConsole->append("Added Resistor (1kΩ) between nodes 1 and 2.", "Circuit");
     ComponentItem *resistor = new ComponentItem("Resistor", componentX, 0);
     scene->addItem(resistor);
     connect(resistor, &ComponentItem::positionChanged, this, &MainWindow::onComponentMoved);
@@ -103,7 +133,7 @@ void MainWindow::addResistor() {
 
 void MainWindow::addCapacitor() {
     circuit.addComponent("Capacitor", 0.01, 2, 3);
-    logConsole->append("Added Capacitor (10nF) between nodes 2 and 3.");
+    logConsole->append("Added Capacitor (10nF) between nodes 2 and 3.", "Circuit");
     ComponentItem *capacitor = new ComponentItem("Capacitor", componentX, 0);
     scene->addItem(capacitor);
     connect(capacitor, &ComponentItem::positionChanged, this, &MainWindow::onComponentMoved);
@@ -111,12 +141,215 @@ void MainWindow::addCapacitor() {
     capacitor->setFlag(QGraphicsItem::ItemIsMovable, !deleteMode);
 }
 
+void MainWindow::importNetlist() {
+    if (importWatcher && importWatcher->isRunning()) {
+        logConsole->append("A netlist import is already running.", "Error");
+        return;
+    }
+    QString filename = QFileDialog::getOpenFileName(this, "Import Netlist", QString(),
+                                                    "SPICE netlists (*.cir *.sp *.spi *.net *.ckt);;All files (*)");
+    if (filename.isEmpty()) return;
+
+    // Place the imported parts below everything already in the scene, on the grid
+    const int gridSize = 20;
+    QRectF existing = scene->itemsBoundingRect();
+    QPointF origin(qRound(existing.left() / gridSize) * gridSize,
+                   (qRound(existing.bottom() / gridSize) + 3) * gridSize);
+
+    if (!importWatcher) {
+        importWatcher = new QFutureWatcher<NetlistImport>(this);
+        connect(importWatcher, &QFutureWatcher<NetlistImport>::finished, this, &MainWindow::onNetlistLoaded);
+    }
+    logConsole->append("Importing " + filename + "...", "Circuit");
+    importWatcher->setFuture(QtConcurrent::run(loadNetlist, filename, origin));
+}
+
+void MainWindow::onNetlistLoaded() {
+    NetlistImport netlist = importWatcher->result();
+    if (!netlist.ok) {
+        logConsole->append("Failed to import " + netlist.filename, "Error");
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    insertComponents(netlist);
+    logConsole->append(QString("Imported %1 components from %2 (parse %3 ms, layout %4 ms, insert %5 ms)")
+                           .arg(netlist.components.size())
+                           .arg(netlist.filename)
+                           .arg(netlist.parseMs)
+                           .arg(netlist.layoutMs)
+                           .arg(timer.elapsed()),
+                       "Circuit");
+}
+
+Cathedral::JobScheduler *MainWindow::jobScheduler() {
+    if (scheduler) return scheduler.get();
+
+    // CATHEDRAL_SIMULATOR selects an external simulator, e.g. "ngspice -b {netlist}"
+    std::shared_ptr<Cathedral::SimulationBackend> backend;
+    const QString simulator = qEnvironmentVariable("CATHEDRAL_SIMULATOR");
+    if (simulator.isEmpty()) {
+        // Reductions are memoized per subcircuit across batches and sessions
+        const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/results";
+        backend = std::make_shared<Cathedral::BuiltinBackend>(
+            Cathedral::PrimaOptions(), std::make_shared<Cathedral::ResultCache>(cacheDir.toStdString()));
+    } else {
+        std::vector<std::string> command;
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+        const auto skipEmpty = Qt::SkipEmptyParts;
+#else
+        const auto skipEmpty = QString::SkipEmptyParts;
+#endif
+        for (const QString &arg : simulator.split(' ', skipEmpty)) {
+            command.push_back(arg.toStdString());
+        }
+        backend = std::make_shared<Cathedral::ExternalSimulatorBackend>(command);
+    }
+    scheduler = std::make_unique<Cathedral::JobScheduler>(backend);
+
+    // Called on worker threads; the console queues lines and the summary hops to the GUI thread
+    ConsoleDock *console = logConsole;
+    scheduler->setListener([this, console](const Cathedral::JobEvent &event) {
+        const QString prefix = QString("[job %1] ").arg(event.jobId);
+        const QString text = QString::fromStdString(event.text);
+        switch (event.kind) {
+            case Cathedral::JobEvent::Kind::Started:
+                console->append(prefix + "started " + text, "Simulation");
+                break;
+            case Cathedral::JobEvent::Kind::Output:
+                console->append(prefix + text, "Simulation");
+                break;
+            case Cathedral::JobEvent::Kind::Finished:
+                console->append(prefix + Cathedral::JobStatusName(event.status) + ": " + text,
+                                event.status == Cathedral::JobStatus::Succeeded ? "Simulation" : "Error");
+                QMetaObject::invokeMethod(this, &MainWindow::onSimulationJobFinished, Qt::QueuedConnection);
+                break;
+        }
+    });
+    logConsole->append(QString("Simulation backend: %1, %2 workers")
+                           .arg(QString::fromStdString(backend->name()))
+                           .arg(scheduler->workerCount()),
+                       "Simulation");
+    return scheduler.get();
+}
+
+void MainWindow::runNetlistBatch() {
+    QStringList filenames = QFileDialog::getOpenFileNames(this, "Run Netlists", QString(),
+                                                          "SPICE netlists (*.cir *.sp *.spi *.net *.ckt);;All files (*)");
+    if (filenames.isEmpty()) return;
+
+    Cathedral::JobScheduler *jobs = jobScheduler();
+    Cathedral::SchedulerStats stats = jobs->stats();
+    if (stats.completed() == stats.submitted) {
+        jobs->resetStats();  // Idle: measure this batch on its own
+    }
+    for (const QString &filename : filenames) {
+        QFile file(filename);
+        if (!file.open(QIODevice::ReadOnly)) {
+            logConsole->append("Failed to open " + filename, "Error");
+            continue;
+        }
+        Cathedral::SimulationJob job;
+        job.name = QFileInfo(filename).fileName().toStdString();
+        job.netlist = file.readAll().toStdString();
+        job.limits.timeoutSeconds = 300.0;
+        job.limits.memoryBytes = 4ull << 30;
+        jobs->submit(std::move(job));
+    }
+    logConsole->append(QString("Queued %1 simulation jobs").arg(filenames.size()), "Simulation");
+}
+
+void MainWindow::cancelSimulations() {
+    if (!scheduler) return;
+    scheduler->cancelAll();
+    logConsole->append("Cancelling queued and running simulations", "Simulation");
+}
+
+void MainWindow::onSimulationJobFinished() {
+    if (!scheduler) return;
+    scheduler->takeResults();  // Lines were already streamed to the console
+    Cathedral::SchedulerStats stats = scheduler->stats();
+    if (stats.completed() != stats.submitted) return;
+    logConsole->append(QString("Simulation batch done: %1 succeeded, %2 failed, %3 timed out, %4 cancelled in %5 s "
+                               "(%6 jobs/s, %7 us scheduling overhead per job)")
+                           .arg(stats.succeeded)
+                           .arg(stats.failed)
+                           .arg(stats.timedOut)
+                           .arg(stats.cancelled)
+                           .arg(stats.wallSeconds, 0, 'f', 2)
+                           .arg(stats.jobsPerSecond(), 0, 'f', 1)
+                           .arg(stats.overheadPerJobMicroseconds(), 0, 'f', 1),
+                       "Simulation");
+}
+
+void MainWindow::insertComponents(const NetlistImport &netlist) {
+    circuit.addComponents(netlist.components);
+
+    // Without an index, addItem is a plain append; the BSP tree is rebuilt once at the end
+    schematicView->setUpdatesEnabled(false);
+    scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    QVector<ComponentItem*> items;
+    items.reserve(static_cast<int>(netlist.components.size()));
+    for (std::size_t i = 0; i < netlist.components.size(); ++i) {
+        const QPointF &pos = netlist.positions[static_cast<int>(i)];
+        ComponentItem *item = new ComponentItem(QString::fromStdString(netlist.components[i].type),
+                                                qRound(pos.x()), qRound(pos.y()));
+        item->setFlag(QGraphicsItem::ItemIsMovable, !deleteMode);
+        scene->addItem(item);
+        connect(item, &ComponentItem::positionChanged, this, &MainWindow::onComponentMoved);
+        items.append(item);
+    }
+
+    // Chain the pins of each net with Manhattan wires: node1 is the left terminal,
+    // node2 the right one. Ground is left unwired, it would tie every group together
+    const QPointF leftTerminal(-15, 0), rightTerminal(15, 0);
+    const int gridSize = 20;
+    auto snapped = [gridSize](const QPointF &point) {
+        return QPointF(qRound(point.x() / gridSize) * gridSize, qRound(point.y() / gridSize) * gridSize);
+    };
+    QHash<int, QPair<ComponentItem*, QPointF>> lastPin;
+    int wires = 0;
+    for (int i = 0; i < items.size(); ++i) {
+        const Cathedral::CircuitComponent &part = netlist.components[static_cast<std::size_t>(i)];
+        const int nodes[2] = {part.node1, part.node2};
+        const QPointF locals[2] = {leftTerminal, rightTerminal};
+        for (int pin = 0; pin < 2; ++pin) {
+            if (nodes[pin] == 0) continue;
+            auto previous = lastPin.find(nodes[pin]);
+            if (previous != lastPin.end()) {
+                WireConnection connection;
+                connection.startComponent = previous->first;
+                connection.startLocal = previous->second;
+                connection.startTerminal = snapped(previous->first->mapToScene(previous->second));
+                connection.endComponent = items[i];
+                connection.endLocal = locals[pin];
+                connection.endTerminal = snapped(items[i]->mapToScene(locals[pin]));
+                const QPointF &start = connection.startTerminal, &end = connection.endTerminal;
+                if (start != end) {
+                    connection.segments.append(new WireItem(start, QPointF(end.x(), start.y())));
+                    connection.segments.append(new WireItem(QPointF(end.x(), start.y()), end));
+                    for (WireItem *segment : connection.segments) {
+                        scene->addItem(segment);
+                    }
+                }
+                wireConnections.append(connection);
+                ++wires;
+            }
+            lastPin.insert(nodes[pin], qMakePair(items[i], locals[pin]));
+        }
+    }
+    logConsole->append(QString("Wired %1 connections across %2 nets").arg(wires).arg(lastPin.size()), "Circuit");
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    schematicView->setUpdatesEnabled(true);
+}
+
 void MainWindow::startWire(QPointF start) {
     if (!wireMode || drawingWire || deleteMode) return;
     drawingWire = true;
     wireStartPoint = start;
     currentWire = nullptr;
-    logConsole->append("Wire started at (" + QString::number(start.x()) + ", " + QString::number(start.y()) + ")");
+    logConsole->append("Wire started at (" + QString::number(start.x()) + ", " + QString::number(start.y()) + ")", "Wire");
     qDebug() << "Wire started at" << start;
 }
 
@@ -141,7 +374,7 @@ void MainWindow::finishWire(QPointF end) {
     }
 
     if (!startComponent || !endComponent) {
-        logConsole->append("Error: Must connect two components.");
+        logConsole->append("Must connect two components.", "Error");
         drawingWire = false;
         return;
     }
@@ -178,6 +411,8 @@ void MainWindow::finishWire(QPointF end) {
     connection.startTerminal = startTerminal;
     connection.endComponent = endComponent;
     connection.endTerminal = endTerminal;
+    connection.startLocal = startComponent->mapFromScene(startTerminal);
+    connection.endLocal = endComponent->mapFromScene(endTerminal);
     connection.segments = wireSegments;
     wireConnections.append(connection);
 
@@ -188,13 +423,12 @@ void MainWindow::finishWire(QPointF end) {
 
     drawingWire = false;
     logConsole->append("Wire completed between (" + QString::number(startTerminal.x()) + ", " + QString::number(startTerminal.y()) +
-                       ") and (" + QString::number(endTerminal.x()) + ", " + QString::number(endTerminal.y()) + ")");
+                       ") and (" + QString::number(endTerminal.x()) + ", " + QString::number(endTerminal.y()) + ")", "Wire");
     scene->update();
 }
 
 void MainWindow::onComponentMoved(ComponentItem *component) {
-    qDebug() << "Component moved:" << component->getType() << "to" << component->pos();
-
+    // Runs on every positionChanged while dragging, so nothing is logged here
     // Update all wires connected to this component
     for (WireConnection &connection : wireConnections) {
         if (connection.startComponent == component || connection.endComponent == component) {
@@ -206,8 +440,8 @@ void MainWindow::onComponentMoved(ComponentItem *component) {
             connection.segments.clear();
 
             // Recalculate terminals based on new positions
-            QPointF startTerminal = connection.startComponent->getNearestTerminal(connection.startComponent->pos());
-            QPointF endTerminal = connection.endComponent->getNearestTerminal(connection.endComponent->pos());
+            QPointF startTerminal = connection.startComponent->mapToScene(connection.startLocal);
+            QPointF endTerminal = connection.endComponent->mapToScene(connection.endLocal);
 
             // Snap to grid
             int gridSize = 20;
@@ -232,8 +466,6 @@ void MainWindow::onComponentMoved(ComponentItem *component) {
                     scene->addItem(segment);
                 }
             }
-
-            qDebug() << "Updated wire between" << startTerminal << "and" << endTerminal;
         }
     }
     scene->update();
@@ -258,7 +490,7 @@ void MainWindow::deleteComponent(ComponentItem *component) {
 
     // Remove the component from the scene
     scene->removeItem(component);
-    logConsole->append("Deleted component: " + component->getType());
+    logConsole->append("Deleted component: " + component->getType(), "Circuit");
     delete component;
 }
 
@@ -275,23 +507,23 @@ void MainWindow::deleteWire(WireItem *wire) {
             }
             connection.segments.clear();
             wireConnections.removeAt(i);
-            logConsole->append("Deleted wire");
+            logConsole->append("Deleted wire", "Wire");
             break;
         }
     }
 }
 
 void MainWindow::listCircuit() {
-    logConsole->append("Listing all circuit components:");
+    logConsole->append("Listing all circuit components:", "Circuit");
     circuit.listComponents();
-    QString visualList = "Visual Components:\n";
+    // One console line per component keeps rows uniform for the list view
+    logConsole->append("Visual Components:", "Circuit");
     for (auto *item : scene->items()) {
         if (auto *comp = dynamic_cast<ComponentItem*>(item)) {
-            visualList += comp->getType() + " at (" + QString::number(comp->pos().x()) + ", " +
-                          QString::number(comp->pos().y()) + ")\n";
+            logConsole->append(comp->getType() + " at (" + QString::number(comp->pos().x()) + ", " +
+                               QString::number(comp->pos().y()) + ")", "Circuit");
         }
     }
-    logConsole->append(visualList);
 }
 
 void MainWindow::toggleWireMode(bool enabled) {
@@ -305,7 +537,7 @@ void MainWindow::toggleWireMode(bool enabled) {
             toggleDeleteMode(false);
         }
         schematicView->setDragMode(QGraphicsView::NoDrag);
-        logConsole->append("Wire Mode ON");
+        logConsole->append("Wire Mode ON", "Mode");
     } else {
         if (!deleteMode) {
             schematicView->setDragMode(QGraphicsView::RubberBandDrag);
@@ -316,10 +548,15 @@ void MainWindow::toggleWireMode(bool enabled) {
                 }
             }
         }
-        logConsole->append("Wire Mode OFF");
+        logConsole->append("Wire Mode OFF", "Mode");
     }
 }
 
+void MainWindow::toggleOpenGLViewport(bool enabled) {
+    schematicView->setOpenGLEnabled(enabled);
+    logConsole->append(enabled ? "OpenGL Viewport ON" : "OpenGL Viewport OFF", "Mode");
+}
+
 void MainWindow::toggleDeleteMode(bool enabled) {
     if (deleteMode == enabled) return;
     deleteMode = enabled;
@@ -332,13 +569,14 @@ void MainWindow::toggleDeleteMode(bool enabled) {
         }
         schematicView->setDragMode(QGraphicsView::NoDrag);
         // Disable dragging for all components
+        int locked = 0;
         for (auto *item : scene->items()) {
             if (auto *comp = dynamic_cast<ComponentItem*>(item)) {
                 comp->setFlag(QGraphicsItem::ItemIsMovable, false);
-                qDebug() << "Disabled movable for:" << comp->getType();
+                ++locked;
             }
         }
-        logConsole->append("Delete Mode ON");
+        logConsole->append(QString("Delete Mode ON (%1 components locked)").arg(locked), "Mode");
     } else {
         if (!wireMode) {
             schematicView->setDragMode(QGraphicsView::RubberBandDrag);
@@ -346,11 +584,10 @@ void MainWindow::toggleDeleteMode(bool enabled) {
             for (auto *item : scene->items()) {
                 if (auto *comp = dynamic_cast<ComponentItem*>(item)) {
                     comp->setFlag(QGraphicsItem::ItemIsMovable, true);
-                    qDebug() << "Enabled movable for:" << comp->getType();
                 }
             }
         }
-        logConsole->append("Delete Mode OFF");
+        logConsole->append("Delete Mode OFF", "Mode");
     }
     qDebug() << "Delete Mode set to:" << deleteMode << "Drag Mode:" << schematicView->dragMode();
 }
@@ -0,0 +1,104 @@
+#include "gui/netlist_import.h"
+#include "parser/netlist_parser.h"
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+namespace {
+    // Multiples of the 20-unit schematic grid
+    const qreal columnSpacing = 60;
+    const qreal rowSpacing = 40;
+    const qreal groupGap = 40;
+}
+
+QVector<QPointF> layoutComponents(const std::vector<Cathedral::CircuitComponent>& components, const QPointF& origin) {
+    const int count = static_cast<int>(components.size());
+    QVector<QPointF> positions(count);
+    if (count == 0) return positions;
+
+    // Components on each non-ground net; ground would tie everything together
+    std::unordered_map<int, std::vector<int>> nets;
+    nets.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        if (components[i].node1 != 0) nets[components[i].node1].push_back(i);
+        if (components[i].node2 != 0 && components[i].node2 != components[i].node1) nets[components[i].node2].push_back(i);
+    }
+
+    std::vector<char> placed(count, 0);
+    std::unordered_map<int, char> netVisited;
+    netVisited.reserve(nets.size());
+
+    const qreal shelfWidth = std::max<qreal>(20 * columnSpacing, std::sqrt(static_cast<qreal>(count)) * columnSpacing * 1.5);
+    qreal shelfX = 0, shelfY = 0, shelfHeight = 0;
+
+    std::vector<int> group, layerOf;
+    layerOf.assign(count, 0);
+    for (int seed = 0; seed < count; ++seed) {
+        if (placed[seed]) continue;
+
+        // BFS over the component/net graph; each net is expanded once, so
+        // large fan-out nets cost their size only one time
+        group.clear();
+        group.push_back(seed);
+        placed[seed] = 1;
+        layerOf[seed] = 0;
+        for (std::size_t head = 0; head < group.size(); ++head) {
+            const Cathedral::CircuitComponent& part = components[group[head]];
+            for (int node : {part.node1, part.node2}) {
+                if (node == 0 || netVisited[node]) continue;
+                netVisited[node] = 1;
+                for (int next : nets[node]) {
+                    if (placed[next]) continue;
+                    placed[next] = 1;
+                    layerOf[next] = layerOf[group[head]] + 1;
+                    group.push_back(next);
+                }
+            }
+        }
+
+        // BFS order is already sorted by layer; tall layers wrap into extra columns
+        const int maxRows = std::max(8, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(group.size())))));
+        int column = -1, row = maxRows, currentLayer = -1, rowsUsed = 0;
+        for (int index : group) {
+            if (layerOf[index] != currentLayer || row == maxRows) {
+                currentLayer = layerOf[index];
+                ++column;
+                row = 0;
+            }
+            positions[index] = QPointF(column * columnSpacing, row * rowSpacing);
+            ++row;
+            rowsUsed = std::max(rowsUsed, row);
+        }
+
+        const qreal width = (column + 1) * columnSpacing;
+        const qreal height = rowsUsed * rowSpacing;
+        if (shelfX > 0 && shelfX + width > shelfWidth) {
+            shelfX = 0;
+            shelfY += shelfHeight + groupGap;
+            shelfHeight = 0;
+        }
+        const QPointF offset = origin + QPointF(shelfX, shelfY);
+        for (int index : group) {
+            positions[index] += offset;
+        }
+        shelfX += width + groupGap;
+        shelfHeight = std::max(shelfHeight, height);
+    }
+    return positions;
+}
+
+NetlistImport loadNetlist(const QString& filename, const QPointF& origin) {
+    NetlistImport result;
+    result.filename = filename;
+
+    QElapsedTimer timer;
+    timer.start();
+    result.ok = Cathedral::ReadSpiceNetlistFile(filename.toStdString(), result.components);
+    result.parseMs = timer.restart();
+    if (!result.ok) return result;
+
+    result.positions = layoutComponents(result.components, origin);
+    result.layoutMs = timer.elapsed();
+    return result;
+}
@@ -0,0 +1,229 @@
+#include "gui/schematic_batch.h"
+#include "gui/component_item.h"
+#include "gui/wire_item.h"
+#include <QGraphicsScene>
+#include <cmath>
+
+namespace {
+    const qreal tileSize = 512;
+    const QRectF symbolExtent(-15, -10, 30, 20);  // Matches ComponentItem::boundingRect()
+}
+
+SchematicBatch::SchematicBatch(QGraphicsScene *scene)
+    : QObject(scene), scene(scene) {
+    setObjectName("SchematicBatch");
+}
+
+SchematicBatch *SchematicBatch::forScene(QGraphicsScene *scene) {
+    if (!scene) return nullptr;
+    SchematicBatch *batch = scene->findChild<SchematicBatch*>("SchematicBatch", Qt::FindDirectChildrenOnly);
+    return batch ? batch : new SchematicBatch(scene);
+}
+
+QPoint SchematicBatch::tileOf(const QPointF &point) {
+    return QPoint(static_cast<int>(std::floor(point.x() / tileSize)), static_cast<int>(std::floor(point.y() / tileSize)));
+}
+
+void SchematicBatch::refresh() {
+    // Items switch between self-painting and batched drawing, so repaint everything
+    if (scene) scene->update();
+}
+
+void SchematicBatch::updateFlag(QGraphicsItem *item, bool batched) {
+    // Selected and active items paint themselves, for the highlight and so the scene can hit them.
+    // setFlag() returns early when nothing changes, so re-registering a moved item is cheap
+    item->setFlag(QGraphicsItem::ItemHasNoContents, batched && item != activeItem && !item->isSelected());
+}
+
+void SchematicBatch::refreshFlag(QGraphicsItem *item) {
+    if (auto *wire = dynamic_cast<WireItem*>(item)) {
+        updateFlag(wire, enabled && wireSlots.contains(wire));
+    } else if (auto *symbol = dynamic_cast<ComponentItem*>(item)) {
+        updateFlag(symbol, symbolsBatched() && symbolSlots.contains(symbol));
+    }
+}
+
+void SchematicBatch::updateItemFlags() {
+    for (auto it = wireSlots.cbegin(); it != wireSlots.cend(); ++it) updateFlag(it.key(), enabled);
+    for (auto it = symbolSlots.cbegin(); it != symbolSlots.cend(); ++it) updateFlag(it.key(), symbolsBatched());
+}
+
+void SchematicBatch::setEnabled(bool on) {
+    if (enabled == on) return;
+    enabled = on;
+    updateItemFlags();
+    refresh();
+}
+
+void SchematicBatch::setInstancedSymbols(bool on) {
+    if (instancedSymbols == on) return;
+    instancedSymbols = on;
+    updateItemFlags();
+    refresh();
+}
+
+void SchematicBatch::setActiveItem(QGraphicsItem *item) {
+    if (activeItem == item) return;
+    QGraphicsItem *previous = activeItem;
+    activeItem = item;
+    if (previous) refreshFlag(previous);
+    if (item) refreshFlag(item);
+}
+
+void SchematicBatch::itemSelectionChanged(QGraphicsItem *item) {
+    refreshFlag(item);
+}
+
+void SchematicBatch::addWire(WireItem *wire, const QLineF &line, QRgb color) {
+    unlinkWire(wire);  // Unlike removeWire(), an active wire stays active
+    QPoint key = tileOf(line.center());
+    Tile &tile = tiles[key];
+    tile.wires[color].insert(wire, line);
+    tile.bounds |= QRectF(line.p1(), line.p2()).normalized().adjusted(-1, -1, 1, 1);
+    touch(tile);
+    wireSlots.insert(wire, qMakePair(key, color));
+    updateFlag(wire, enabled);
+}
+
+void SchematicBatch::removeWire(WireItem *wire) {
+    if (activeItem == wire) activeItem = nullptr;
+    unlinkWire(wire);
+}
+
+void SchematicBatch::unlinkWire(WireItem *wire) {
+    auto slot = wireSlots.find(wire);
+    if (slot == wireSlots.end()) return;
+    auto tile = tiles.find(slot->first);
+    if (tile != tiles.end()) {
+        auto bucket = tile->wires.find(slot->second);
+        if (bucket != tile->wires.end()) {
+            bucket->remove(wire);
+            if (bucket->isEmpty()) tile->wires.erase(bucket);
+        }
+        touch(*tile);
+    }
+    wireSlots.erase(slot);
+}
+
+void SchematicBatch::addSymbol(ComponentItem *symbol, const QString &type, const QPointF &pos) {
+    unlinkSymbol(symbol);  // Unlike removeSymbol(), a dragged symbol stays active
+    QPoint key = tileOf(pos);
+    Tile &tile = tiles[key];
+    tile.symbols[type].insert(symbol, pos);
+    tile.bounds |= symbolExtent.translated(pos);
+    touch(tile);
+    symbolSlots.insert(symbol, qMakePair(key, type));
+    updateFlag(symbol, symbolsBatched());
+}
+
+void SchematicBatch::removeSymbol(ComponentItem *symbol) {
+    if (activeItem == symbol) activeItem = nullptr;
+    unlinkSymbol(symbol);
+}
+
+void SchematicBatch::unlinkSymbol(ComponentItem *symbol) {
+    auto slot = symbolSlots.find(symbol);
+    if (slot == symbolSlots.end()) return;
+    auto tile = tiles.find(slot->first);
+    if (tile != tiles.end()) {
+        auto bucket = tile->symbols.find(slot->second);
+        if (bucket != tile->symbols.end()) {
+            bucket->remove(symbol);
+            if (bucket->isEmpty()) tile->symbols.erase(bucket);
+        }
+        touch(*tile);
+    }
+    symbolSlots.erase(slot);
+}
+
+QGraphicsItem *SchematicBatch::itemAt(const QPointF &scenePos) const {
+    WireItem *hitWire = nullptr;
+    for (auto tile = tiles.cbegin(); tile != tiles.cend(); ++tile) {
+        if (!tile->bounds.contains(scenePos)) continue;
+        if (symbolsBatched()) {
+            for (auto bucket = tile->symbols.cbegin(); bucket != tile->symbols.cend(); ++bucket) {
+                for (auto it = bucket->cbegin(); it != bucket->cend(); ++it) {
+                    if (symbolExtent.translated(it.value()).contains(scenePos)) return it.key();
+                }
+            }
+        }
+        if (hitWire || !enabled) continue;
+        for (auto bucket = tile->wires.cbegin(); bucket != tile->wires.cend() && !hitWire; ++bucket) {
+            for (auto it = bucket->cbegin(); it != bucket->cend(); ++it) {
+                if (it.key()->contains(it.key()->mapFromScene(scenePos))) {
+                    hitWire = it.key();
+                    break;
+                }
+            }
+        }
+    }
+    return hitWire;
+}
+
+void SchematicBatch::selectIn(const QRectF &sceneRect) {
+    for (auto tile = tiles.cbegin(); tile != tiles.cend(); ++tile) {
+        if (!tile->bounds.intersects(sceneRect)) continue;
+        if (symbolsBatched()) {
+            for (auto bucket = tile->symbols.cbegin(); bucket != tile->symbols.cend(); ++bucket) {
+                for (auto it = bucket->cbegin(); it != bucket->cend(); ++it) {
+                    if (symbolExtent.translated(it.value()).intersects(sceneRect)) it.key()->setSelected(true);
+                }
+            }
+        }
+        for (auto bucket = tile->wires.cbegin(); bucket != tile->wires.cend(); ++bucket) {
+            for (auto it = bucket->cbegin(); it != bucket->cend(); ++it) {
+                const QLineF &line = it.value();
+                if (QRectF(line.p1(), line.p2()).normalized().adjusted(-1, -1, 1, 1).intersects(sceneRect)) {
+                    it.key()->setSelected(true);  // A no-op for items that are not selectable
+                }
+            }
+        }
+    }
+}
+
+void SchematicBatch::collect(const QRectF &rect, QHash<QRgb, QVector<QLineF>> &lines,
+                             QHash<QString, QVector<QPointF>> &symbols) const {
+    for (auto it = lines.begin(); it != lines.end(); ++it) it->clear();
+    for (auto it = symbols.begin(); it != symbols.end(); ++it) it->clear();
+
+    for (auto tile = tiles.cbegin(); tile != tiles.cend(); ++tile) {
+        if (!tile->bounds.intersects(rect)) continue;
+        for (auto bucket = tile->wires.cbegin(); bucket != tile->wires.cend(); ++bucket) {
+            QVector<QLineF> &out = lines[bucket.key()];
+            for (const QLineF &line : *bucket) out.append(line);
+        }
+        for (auto bucket = tile->symbols.cbegin(); bucket != tile->symbols.cend(); ++bucket) {
+            QVector<QPointF> &out = symbols[bucket.key()];
+            for (const QPointF &pos : *bucket) out.append(pos);
+        }
+    }
+}
+
+void SchematicBatch::tilesIn(const QRectF &rect, QVector<QPoint> &keys) const {
+    keys.clear();
+    for (auto tile = tiles.cbegin(); tile != tiles.cend(); ++tile) {
+        if (tile->bounds.intersects(rect)) keys.append(tile.key());
+    }
+}
+
+quint64 SchematicBatch::tileRevision(const QPoint &key) const {
+    auto tile = tiles.constFind(key);
+    return tile == tiles.cend() ? 0 : tile->revision;
+}
+
+void SchematicBatch::tileGeometry(const QPoint &key, QHash<QRgb, QVector<QLineF>> &lines,
+                                  QHash<QString, QVector<QPointF>> &symbols) const {
+    for (auto it = lines.begin(); it != lines.end(); ++it) it->clear();
+    for (auto it = symbols.begin(); it != symbols.end(); ++it) it->clear();
+
+    auto tile = tiles.constFind(key);
+    if (tile == tiles.cend()) return;
+    for (auto bucket = tile->wires.cbegin(); bucket != tile->wires.cend(); ++bucket) {
+        QVector<QLineF> &out = lines[bucket.key()];
+        for (const QLineF &line : *bucket) out.append(line);
+    }
+    for (auto bucket = tile->symbols.cbegin(); bucket != tile->symbols.cend(); ++bucket) {
+        QVector<QPointF> &out = symbols[bucket.key()];
+        for (const QPointF &pos : *bucket) out.append(pos);
+    }
+}
@@ -0,0 +1,427 @@
+#include "gui/schematic_view.h"
+#include "gui/component_item.h"
+#include <QImage>
+#include <QMatrix4x4>
+#include <QMouseEvent>
+#include <QOpenGLContext>
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLFunctions>
+#include <QOpenGLShaderProgram>
+#include <QOpenGLTexture>
+#include <QOpenGLWidget>
+#include <QPaintEngine>
+#include <QPainter>
+#include <QSurfaceFormat>
+#include <QtMath>
+#include <QDebug>
+
+namespace {
+    const int gridSize = 20;
+    const int gridExtent = 500;
+    const int symbolTexelsPerUnit = 4;  // Keeps symbols sharp when zoomed in a few steps
+
+    const char *lineVertexShader =
+        "attribute highp vec2 position;\n"
+        "uniform highp mat4 mvp;\n"
+        "void main() { gl_Position = mvp * vec4(position, 0.0, 1.0); }\n";
+    const char *lineFragmentShader =
+        "uniform lowp vec4 color;\n"
+        "void main() { gl_FragColor = color; }\n";
+
+    // One quad per symbol type, one instance (scene offset) per component
+    const char *symbolVertexShader =
+        "attribute highp vec2 corner;\n"
+        "attribute highp vec2 uv;\n"
+        "attribute highp vec2 offset;\n"
+        "uniform highp mat4 mvp;\n"
+        "varying mediump vec2 texCoord;\n"
+        "void main() { texCoord = uv; gl_Position = mvp * vec4(corner + offset, 0.0, 1.0); }\n";
+    const char *symbolFragmentShader =
+        "uniform sampler2D symbol;\n"
+        "varying mediump vec2 texCoord;\n"
+        "void main() { gl_FragColor = texture2D(symbol, texCoord); }\n";
+
+    // Triangle strip over ComponentItem::boundingRect(): x, y, u, v
+    const float symbolQuad[] = {
+        -15.0f, -10.0f, 0.0f, 0.0f,
+         15.0f, -10.0f, 1.0f, 0.0f,
+        -15.0f,  10.0f, 0.0f, 1.0f,
+         15.0f,  10.0f, 1.0f, 1.0f,
+    };
+}
+
+SchematicView::SchematicView(QWidget *parent)
+    : QGraphicsView(parent),
+      quadBuffer(QOpenGLBuffer::VertexBuffer) {
+    setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+    setCacheMode(QGraphicsView::CacheBackground);
+}
+
+SchematicView::~SchematicView() {
+    // The viewport outlives this destructor body, so free GL objects while members still exist
+    if (auto *gl = qobject_cast<QOpenGLWidget*>(viewport())) {
+        disconnect(gl, nullptr, this, nullptr);
+        gl->makeCurrent();
+        releaseGLResources();
+        gl->doneCurrent();
+    }
+}
+
+void SchematicView::setOpenGLEnabled(bool enabled) {
+    if (openGL == enabled) return;
+
+    if (auto *gl = qobject_cast<QOpenGLWidget*>(viewport())) {
+        disconnect(gl, nullptr, this, nullptr);
+        gl->makeCurrent();
+        releaseGLResources();
+        gl->doneCurrent();
+    }
+
+    openGL = enabled;
+    if (enabled) {
+        QOpenGLWidget *gl = new QOpenGLWidget();
+        QSurfaceFormat format = gl->format();
+        format.setSamples(4);
+        gl->setFormat(format);
+        connect(gl, &QOpenGLWidget::aboutToBeDestroyed, this, [this, gl]() {
+            gl->makeCurrent();
+            releaseGLResources();
+            gl->doneCurrent();
+        });
+        setViewport(gl);
+        // QOpenGLWidget recomposes its whole framebuffer, so partial updates gain nothing there
+        setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+        setCacheMode(QGraphicsView::CacheNone);
+    } else {
+        setViewport(new QWidget());
+        setViewportUpdateMode(QGraphicsView::SmartViewportUpdate);
+        setCacheMode(QGraphicsView::CacheBackground);
+    }
+
+    if (SchematicBatch *sceneBatch = currentBatch()) {
+        sceneBatch->setEnabled(enabled);
+        if (!enabled) sceneBatch->setInstancedSymbols(false);
+    }
+}
+
+SchematicBatch *SchematicView::currentBatch() {
+    SchematicBatch *sceneBatch = SchematicBatch::forScene(scene());
+    if (sceneBatch != batch) {
+        batch = sceneBatch;
+        tileBuffersStale = true;
+        if (batch) batch->setEnabled(openGL);
+    }
+    return batch;
+}
+
+void SchematicView::drawBackground(QPainter *painter, const QRectF &rect) {
+    QGraphicsView::drawBackground(painter, rect);
+
+    painter->save();
+    drawGrid(painter, rect);
+    SchematicBatch *sceneBatch = currentBatch();
+    if (sceneBatch && sceneBatch->isEnabled()) {
+        // `rect` is the exposed scene area; only tiles overlapping it are drawn
+        QPaintEngine *engine = painter->paintEngine();
+        if (engine && engine->type() == QPaintEngine::OpenGL2 && QOpenGLContext::currentContext()) {
+            drawBatchesGL(painter, rect);
+        } else {
+            sceneBatch->setInstancedSymbols(false);
+            sceneBatch->collect(rect, visibleLines, visibleSymbols);
+            drawBatchesRaster(painter);
+        }
+    }
+    painter->restore();
+}
+
+void SchematicView::activateItemAt(const QPoint &viewPos) {
+    // Batched items have no contents, so the scene's own hit test skips them;
+    // hand the one under the cursor its contents back before the scene looks
+    SchematicBatch *sceneBatch = currentBatch();
+    if (sceneBatch && sceneBatch->isEnabled()) {
+        sceneBatch->setActiveItem(sceneBatch->itemAt(mapToScene(viewPos)));
+    }
+}
+
+void SchematicView::mousePressEvent(QMouseEvent *event) {
+    activateItemAt(event->pos());
+    QGraphicsView::mousePressEvent(event);
+}
+
+void SchematicView::mouseDoubleClickEvent(QMouseEvent *event) {
+    activateItemAt(event->pos());
+    QGraphicsView::mouseDoubleClickEvent(event);
+}
+
+void SchematicView::mouseMoveEvent(QMouseEvent *event) {
+    QGraphicsView::mouseMoveEvent(event);
+    // The rubber band selects through the scene's index, which skips batched items
+    if (dragMode() == QGraphicsView::RubberBandDrag && !rubberBandRect().isNull() && batch && batch->isEnabled()) {
+        batch->selectIn(mapToScene(rubberBandRect()).boundingRect());
+    }
+}
+
+void SchematicView::drawGrid(QPainter *painter, const QRectF &rect) {
+    QRectF area = rect.intersected(QRectF(-gridExtent, -gridExtent, 2 * gridExtent, 2 * gridExtent));
+    if (area.isEmpty()) return;
+
+    QVector<QLineF> lines;
+    for (int x = qCeil(area.left() / gridSize) * gridSize; x <= area.right(); x += gridSize) {
+        lines.append(QLineF(x, area.top(), x, area.bottom()));
+    }
+    for (int y = qCeil(area.top() / gridSize) * gridSize; y <= area.bottom(); y += gridSize) {
+        lines.append(QLineF(area.left(), y, area.right(), y));
+    }
+    painter->setPen(QPen(QColor("#444444")));
+    painter->drawLines(lines);
+}
+
+void SchematicView::drawBatchesRaster(QPainter *painter) {
+    // Still one drawLines() call per colour instead of one paint() per wire
+    for (auto it = visibleLines.cbegin(); it != visibleLines.cend(); ++it) {
+        if (it->isEmpty()) continue;
+        painter->setPen(QPen(QColor::fromRgba(it.key()), 2));
+        painter->drawLines(*it);
+    }
+}
+
+void SchematicView::drawBatchesGL(QPainter *painter, const QRectF &rect) {
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!glReady && !initializeGLResources()) {
+        batch->setInstancedSymbols(false);
+        batch->collect(rect, visibleLines, visibleSymbols);
+        drawBatchesRaster(painter);
+        return;
+    }
+    batch->setInstancedSymbols(glInstancing);
+    if (tileBuffersStale) {
+        releaseTileBuffers();
+        tileBuffersStale = false;
+    }
+
+    QMatrix4x4 mvp;
+    mvp.ortho(0, viewport()->width(), viewport()->height(), 0, -1, 1);
+    mvp *= QMatrix4x4(painter->combinedTransform());
+
+    painter->beginNativePainting();
+    QOpenGLFunctions *gl = context->functions();
+
+    // Upload only what changed since the tile was last drawn
+    batch->tilesIn(rect, visibleTiles);
+    for (const QPoint &key : visibleTiles) {
+        TileBuffers &buffers = tileBuffers[key];
+        if (buffers.revision != batch->tileRevision(key)) {
+            updateTileBuffers(key, buffers);
+        }
+    }
+
+    lineProgram->bind();
+    lineProgram->setUniformValue("mvp", mvp);
+    lineProgram->enableAttributeArray(0);
+    gl->glLineWidth(2.0f);
+    for (const QPoint &key : visibleTiles) {
+        const TileBuffers &buffers = *tileBuffers.constFind(key);
+        for (auto it = buffers.wires.cbegin(); it != buffers.wires.cend(); ++it) {
+            QOpenGLBuffer vertices = it->buffer;
+            vertices.bind();
+            lineProgram->setAttributeBuffer(0, GL_FLOAT, 0, 2);
+            lineProgram->setUniformValue("color", QColor::fromRgba(it.key()));
+            gl->glDrawArrays(GL_LINES, 0, it->count);
+        }
+    }
+    lineProgram->disableAttributeArray(0);
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+    lineProgram->release();
+
+    if (glInstancing) {
+        QOpenGLExtraFunctions *extra = context->extraFunctions();
+        gl->glEnable(GL_BLEND);
+        gl->glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        symbolProgram->bind();
+        symbolProgram->setUniformValue("mvp", mvp);
+        symbolProgram->setUniformValue("symbol", 0);
+        quadBuffer.bind();
+        symbolProgram->enableAttributeArray(0);
+        symbolProgram->setAttributeBuffer(0, GL_FLOAT, 0, 2, 4 * sizeof(float));
+        symbolProgram->enableAttributeArray(1);
+        symbolProgram->setAttributeBuffer(1, GL_FLOAT, 2 * sizeof(float), 2, 4 * sizeof(float));
+        quadBuffer.release();
+
+        symbolProgram->enableAttributeArray(2);
+        extra->glVertexAttribDivisor(2, 1);
+        for (const QPoint &key : visibleTiles) {
+            const TileBuffers &buffers = *tileBuffers.constFind(key);
+            for (auto it = buffers.symbols.cbegin(); it != buffers.symbols.cend(); ++it) {
+                QOpenGLTexture *texture = symbolTexture(it.key());
+                if (!texture) continue;
+                QOpenGLBuffer offsets = it->buffer;
+                offsets.bind();
+                symbolProgram->setAttributeBuffer(2, GL_FLOAT, 0, 2);
+                texture->bind(0);
+                extra->glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, it->count);
+                texture->release(0);
+            }
+        }
+        extra->glVertexAttribDivisor(2, 0);
+        symbolProgram->disableAttributeArray(2);
+        symbolProgram->disableAttributeArray(1);
+        symbolProgram->disableAttributeArray(0);
+        QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+        symbolProgram->release();
+        gl->glDisable(GL_BLEND);
+    }
+
+    painter->endNativePainting();
+}
+
+void SchematicView::updateTileBuffers(const QPoint &key, TileBuffers &buffers) {
+    batch->tileGeometry(key, visibleLines, visibleSymbols);
+
+    // Buffers are kept per colour / type and reallocated in place; ones whose
+    // geometry left the tile are destroyed
+    for (auto it = visibleLines.cbegin(); it != visibleLines.cend(); ++it) {
+        const QVector<QLineF> &lines = *it;
+        if (lines.isEmpty()) continue;
+        vertexScratch.resize(lines.size() * 4);
+        float *vertex = vertexScratch.data();
+        for (const QLineF &line : lines) {
+            *vertex++ = line.x1();
+            *vertex++ = line.y1();
+            *vertex++ = line.x2();
+            *vertex++ = line.y2();
+        }
+        GLBatch &target = buffers.wires[it.key()];
+        if (!target.buffer.isCreated()) {
+            target.buffer.create();
+            target.buffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+        }
+        target.buffer.bind();
+        target.buffer.allocate(vertexScratch.constData(), vertexScratch.size() * int(sizeof(float)));
+        target.buffer.release();
+        target.count = lines.size() * 2;
+    }
+    for (auto it = buffers.wires.begin(); it != buffers.wires.end();) {
+        if (visibleLines.value(it.key()).isEmpty()) {
+            it->buffer.destroy();
+            it = buffers.wires.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (glInstancing) {
+        for (auto it = visibleSymbols.cbegin(); it != visibleSymbols.cend(); ++it) {
+            const QVector<QPointF> &positions = *it;
+            if (positions.isEmpty()) continue;
+            vertexScratch.resize(positions.size() * 2);
+            float *offset = vertexScratch.data();
+            for (const QPointF &pos : positions) {
+                *offset++ = pos.x();
+                *offset++ = pos.y();
+            }
+            GLBatch &target = buffers.symbols[it.key()];
+            if (!target.buffer.isCreated()) {
+                target.buffer.create();
+                target.buffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+            }
+            target.buffer.bind();
+            target.buffer.allocate(vertexScratch.constData(), vertexScratch.size() * int(sizeof(float)));
+            target.buffer.release();
+            target.count = positions.size();
+        }
+    }
+    for (auto it = buffers.symbols.begin(); it != buffers.symbols.end();) {
+        if (!glInstancing || visibleSymbols.value(it.key()).isEmpty()) {
+            it->buffer.destroy();
+            it = buffers.symbols.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    buffers.revision = batch->tileRevision(key);
+}
+
+void SchematicView::releaseTileBuffers() {
+    for (TileBuffers &buffers : tileBuffers) {
+        for (GLBatch &wires : buffers.wires) wires.buffer.destroy();
+        for (GLBatch &symbols : buffers.symbols) symbols.buffer.destroy();
+    }
+    tileBuffers.clear();
+}
+
+bool SchematicView::initializeGLResources() {
+    QOpenGLContext *context = QOpenGLContext::currentContext();
+    if (!context) return false;
+
+    lineProgram = new QOpenGLShaderProgram();
+    lineProgram->addShaderFromSourceCode(QOpenGLShader::Vertex, lineVertexShader);
+    lineProgram->addShaderFromSourceCode(QOpenGLShader::Fragment, lineFragmentShader);
+    lineProgram->bindAttributeLocation("position", 0);
+    if (!lineProgram->link()) {
+        qWarning() << "Wire shader failed to link:" << lineProgram->log();
+        releaseGLResources();
+        return false;
+    }
+    // Instanced arrays are core in desktop GL 3.3 and OpenGL ES 3.0
+    const QSurfaceFormat format = context->format();
+    glInstancing = context->isOpenGLES() ? format.majorVersion() >= 3
+                                         : format.version() >= qMakePair(3, 3);
+    if (glInstancing) {
+        symbolProgram = new QOpenGLShaderProgram();
+        symbolProgram->addShaderFromSourceCode(QOpenGLShader::Vertex, symbolVertexShader);
+        symbolProgram->addShaderFromSourceCode(QOpenGLShader::Fragment, symbolFragmentShader);
+        symbolProgram->bindAttributeLocation("corner", 0);
+        symbolProgram->bindAttributeLocation("uv", 1);
+        symbolProgram->bindAttributeLocation("offset", 2);
+        if (symbolProgram->link()) {
+            quadBuffer.create();
+            quadBuffer.bind();
+            quadBuffer.allocate(symbolQuad, sizeof(symbolQuad));
+            quadBuffer.release();
+        } else {
+            qWarning() << "Symbol shader failed to link, items will paint themselves:" << symbolProgram->log();
+            delete symbolProgram;
+            symbolProgram = nullptr;
+            glInstancing = false;
+        }
+    }
+
+    glReady = true;
+    return true;
+}
+
+void SchematicView::releaseGLResources() {
+    releaseTileBuffers();
+    qDeleteAll(symbolTextures);
+    symbolTextures.clear();
+    delete lineProgram;
+    lineProgram = nullptr;
+    delete symbolProgram;
+    symbolProgram = nullptr;
+    quadBuffer.destroy();
+    glReady = false;
+    glInstancing = false;
+}
+
+QOpenGLTexture *SchematicView::symbolTexture(const QString &type) {
+    auto cached = symbolTextures.constFind(type);
+    if (cached != symbolTextures.cend()) return *cached;
+
+    // Rasterise the item's own symbol once; rows run top to bottom, matching the quad's v
+    QImage image(30 * symbolTexelsPerUnit, 20 * symbolTexelsPerUnit, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter symbolPainter(&image);
+    symbolPainter.scale(symbolTexelsPerUnit, symbolTexelsPerUnit);
+    symbolPainter.translate(15, 10);
+    ComponentItem::paintSymbol(&symbolPainter, type);
+    symbolPainter.end();
+
+    QOpenGLTexture *texture = new QOpenGLTexture(image);
+    texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
+    texture->setMagnificationFilter(QOpenGLTexture::Linear);
+    texture->setWrapMode(QOpenGLTexture::ClampToEdge);
+    symbolTextures.insert(type, texture);
+    return texture;
+}
@@ -1,4 +1,6 @@
 #include "gui/wire_item.h"
+#include "gui/schematic_batch.h"
+#include <QGraphicsScene>
 #include <QPen>
 
 WireItem::WireItem(QPointF start, QPointF end) {
@@ -10,7 +12,31 @@ WireItem::WireItem(QPointF start, QPointF end) {
     setPen(wirePen);
 }
 
+WireItem::~WireItem() {
+    // ~QGraphicsItem removes us from the scene without calling itemChange()
+    if (batch) batch->removeWire(this);
+}
+
 void WireItem::setEndPoint(QPointF end) {
     prepareGeometryChange();
     setLine(QLineF(line().p1(), end));  // ✅ Correct way to update the line
+    if (batch) batch->addWire(this, line(), pen().color().rgba());
+}
+
+void WireItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) {
+    if (batch && batch->isEnabled()) return;  // Drawn by SchematicView with the other wires of this colour
+    QGraphicsLineItem::paint(painter, option, widget);
+}
+
+QVariant WireItem::itemChange(GraphicsItemChange change, const QVariant &value) {
+    if (change == ItemSceneChange && batch) {
+        batch->removeWire(this);
+        batch = nullptr;
+    } else if (change == ItemSceneHasChanged && scene()) {
+        batch = SchematicBatch::forScene(scene());
+        batch->addWire(this, line(), pen().color().rgba());
+    } else if (change == ItemSelectedHasChanged && batch) {
+        batch->itemSelectionChanged(this);
+    }
+    return QGraphicsLineItem::itemChange(change, value);
 }
@@ -0,0 +1,200 @@
+#include "parser/netlist_parser.h"
+#include "util/logging.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <unordered_map>
+
+namespace Cathedral {
+
+    namespace {
+        std::string lower(std::string text) {
+            std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+            return text;
+        }
+
+        bool isInteger(const std::string& text) {
+            return !text.empty() && std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); });
+        }
+
+        const char* elementType(char letter) {
+            switch (std::toupper(static_cast<unsigned char>(letter))) {
+                case 'R': return "Resistor";
+                case 'C': return "Capacitor";
+                case 'L': return "Inductor";
+                case 'D': return "Diode";
+                case 'V': return "VoltageSource";
+                case 'I': return "CurrentSource";
+                default: return nullptr;
+            }
+        }
+    }
+
+    bool ParseSpiceValue(const std::string& text, double& value) {
+        // Scan the numeric prefix by hand: "1f" is femto, not an exponent, and the
+        // GUI runs under the user's locale where strtod may expect a decimal comma
+        auto isDigit = [&](std::size_t i) { return i < text.size() && std::isdigit(static_cast<unsigned char>(text[i])); };
+        std::size_t end = 0;
+        if (end < text.size() && (text[end] == '+' || text[end] == '-')) ++end;
+        std::size_t digits = 0;
+        while (isDigit(end)) { ++end; ++digits; }
+        if (end < text.size() && text[end] == '.') {
+            ++end;
+            while (isDigit(end)) { ++end; ++digits; }
+        }
+        if (digits == 0) {
+            return false;
+        }
+        if (end < text.size() && (text[end] == 'e' || text[end] == 'E')) {
+            std::size_t exponent = end + 1;
+            if (exponent < text.size() && (text[exponent] == '+' || text[exponent] == '-')) ++exponent;
+            if (isDigit(exponent)) {
+                end = exponent;
+                while (isDigit(end)) ++end;
+            }
+        }
+        std::istringstream number(text.substr(0, end));
+        number.imbue(std::locale::classic());
+        if (!(number >> value)) {
+            return false;
+        }
+        std::string suffix = lower(text.substr(end));
+        double scale = 1.0;
+        if (suffix.compare(0, 3, "meg") == 0) scale = 1e6;
+        else if (suffix.compare(0, 3, "mil") == 0) scale = 25.4e-6;
+        else if (!suffix.empty()) {
+            switch (suffix[0]) {
+                case 'f': scale = 1e-15; break;
+                case 'p': scale = 1e-12; break;
+                case 'n': scale = 1e-9; break;
+                case 'u': scale = 1e-6; break;
+                case 'm': scale = 1e-3; break;
+                case 'k': scale = 1e3; break;
+                case 'g': scale = 1e9; break;
+                case 't': scale = 1e12; break;
+                default: break;  // Unit names such as "ohm" or "F" carry no scale
+            }
+        }
+        value *= scale;
+        return true;
+    }
+
+    bool ReadSpiceNetlist(std::istream& in, std::vector<CircuitComponent>& components, bool hasTitle) {
+        // Join continuation lines first so each card is a single logical line
+        std::vector<std::pair<int, std::string>> cards;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(in, line)) {
+            ++lineNumber;
+            if (hasTitle && lineNumber == 1) continue;  // Title card, whatever it contains
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            std::size_t start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line[start] == '*') continue;
+            if (line[start] == '+' && !cards.empty()) {
+                cards.back().second += " " + line.substr(start + 1);
+            } else {
+                cards.emplace_back(lineNumber, line.substr(start));
+            }
+        }
+
+        struct PendingPart {
+            std::string name, type, node1, node2;
+            double value;
+        };
+        std::vector<PendingPart> parts;
+        parts.reserve(cards.size());
+        int maxNumericNode = 0;
+        std::size_t skipped = 0, subcircuits = 0;
+        int subcircuitDepth = 0;
+        bool inControl = false;
+
+        for (const auto& [number, card] : cards) {
+            if (card[0] == '.') {
+                std::string keyword = lower(card.substr(0, card.find_first_of(" \t")));
+                if (inControl) {
+                    inControl = keyword != ".endc";
+                } else if (keyword == ".control") {
+                    inControl = true;
+                } else if (keyword == ".subckt") {
+                    // Bodies use local node names; flattening them would merge those with top-level nets
+                    if (subcircuitDepth++ == 0) ++subcircuits;
+                } else if (keyword == ".ends") {
+                    subcircuitDepth = std::max(0, subcircuitDepth - 1);
+                } else if (keyword == ".end" && subcircuitDepth == 0) {
+                    break;
+                }
+                continue;
+            }
+            if (inControl || subcircuitDepth > 0) {
+                continue;  // Simulator commands, or the body of a subcircuit definition
+            }
+            const char* type = elementType(card[0]);
+            if (!type) {
+                ++skipped;
+                continue;
+            }
+            std::istringstream fields(card);
+            std::string name, node1, node2, valueText;
+            if (!(fields >> name >> node1 >> node2 >> valueText)) {
+                Logger::Log("Netlist line " + std::to_string(number) + ": expected <name> <node> <node> <value>", LogLevel::ERROR);
+                return false;
+            }
+            double value = 0.0;
+            if (!ParseSpiceValue(valueText, value)) {
+                if (card[0] != 'V' && card[0] != 'v' && card[0] != 'I' && card[0] != 'i' &&
+                    card[0] != 'D' && card[0] != 'd') {
+                    Logger::Log("Netlist line " + std::to_string(number) + ": invalid value '" + valueText + "'",
+                                LogLevel::ERROR);
+                    return false;
+                }
+                // Sources may carry "DC 5" or a waveform, diodes a model name; the leading token is not a number then
+                std::string next;
+                if (!(fields >> next) || !ParseSpiceValue(next, value)) value = 0.0;
+            }
+            for (const std::string* node : {&node1, &node2}) {
+                if (isInteger(*node)) maxNumericNode = std::max(maxNumericNode, std::atoi(node->c_str()));
+            }
+            parts.push_back({name, type, node1, node2, value});
+        }
+
+        std::unordered_map<std::string, int> namedNodes;
+        int nextNode = maxNumericNode + 1;
+        auto nodeNumber = [&](const std::string& node) {
+            if (isInteger(node)) return std::atoi(node.c_str());
+            std::string key = lower(node);
+            if (key == "gnd" || key == "gnd!") return 0;
+            auto it = namedNodes.find(key);
+            if (it != namedNodes.end()) return it->second;
+            namedNodes.emplace(key, nextNode);
+            return nextNode++;
+        };
+
+        components.reserve(components.size() + parts.size());
+        for (const PendingPart& part : parts) {
+            components.push_back({part.name, part.type, part.value, nodeNumber(part.node1), nodeNumber(part.node2)});
+        }
+
+        if (skipped > 0) {
+            Logger::Log("Netlist: skipped " + std::to_string(skipped) + " unsupported element lines", LogLevel::WARNING);
+        }
+        if (subcircuits > 0) {
+            Logger::Log("Netlist: skipped " + std::to_string(subcircuits) + " subcircuit definitions", LogLevel::WARNING);
+        }
+        Logger::Log("Read netlist: " + std::to_string(parts.size()) + " components, " +
+                    std::to_string(namedNodes.size()) + " named nodes");
+        return true;
+    }
+
+    bool ReadSpiceNetlistFile(const std::string& filename, std::vector<CircuitComponent>& components, bool hasTitle) {
+        std::ifstream file(filename);
+        if (!file) {
+            Logger::Log("Failed to open netlist: " + filename, LogLevel::ERROR);
+            return false;
+        }
+        return ReadSpiceNetlist(file, components, hasTitle);
+    }
+
+} // namespace Cathedral
@@ -0,0 +1,211 @@
+#include "parser/verilog_reader.h"
+#include "util/logging.h"
+#include <cctype>
+#include <fstream>
+#include <locale>
+#include <sstream>
+#include <unordered_map>
+
+namespace Cathedral {
+
+    namespace {
+        std::string trim(const std::string& text) {
+            std::size_t begin = 0, end = text.size();
+            while (begin < end && std::isspace(static_cast<unsigned char>(text[begin]))) ++begin;
+            while (end > begin && std::isspace(static_cast<unsigned char>(text[end - 1]))) --end;
+            return text.substr(begin, end - begin);
+        }
+
+        std::string stripComments(const std::string& source) {
+            std::string result;
+            result.reserve(source.size());
+            for (std::size_t i = 0; i < source.size(); ++i) {
+                if (source.compare(i, 2, "//") == 0) {
+                    while (i < source.size() && source[i] != '\n') ++i;
+                    result += '\n';
+                } else if (source.compare(i, 2, "/*") == 0) {
+                    std::size_t close = source.find("*/", i + 2);
+                    i = close == std::string::npos ? source.size() : close + 1;
+                    result += ' ';
+                } else {
+                    result += source[i];
+                }
+            }
+            return result;
+        }
+
+        std::vector<std::string> splitList(const std::string& text) {
+            std::vector<std::string> items;
+            std::stringstream stream(text);
+            std::string item;
+            while (std::getline(stream, item, ',')) {
+                item = trim(item);
+                if (!item.empty()) {
+                    items.push_back(item);
+                }
+            }
+            return items;
+        }
+
+        // "#2", "#(1.5)" style delay text; false unless the whole text is a non-negative number
+        bool parseDelay(const std::string& text, double& delay) {
+            std::istringstream stream(trim(text));
+            stream.imbue(std::locale::classic());
+            char extra;
+            return (stream >> delay) && !(stream >> extra) && delay >= 0.0;
+        }
+
+        // One declaration such as "input a", "output wire y" or a bare ANSI
+        // continuation "b". `direction` carries over between list items.
+        bool declarePort(const std::string& item, std::string& direction, LogicNetlist& netlist) {
+            std::istringstream tokens(item);
+            std::vector<std::string> words;
+            for (std::string word; tokens >> word;) words.push_back(word);
+            if (words.empty()) return true;
+            std::size_t first = 0;
+            if (words[0] == "input" || words[0] == "output" || words[0] == "inout") {
+                direction = words[first++];
+            }
+            if (first < words.size() && (words[first] == "wire" || words[first] == "reg")) ++first;
+            if (direction == "inout" || item.find('[') != std::string::npos || first + 1 != words.size()) {
+                Logger::Log("Unsupported port declaration: " + item, LogLevel::ERROR);
+                return false;
+            }
+            int net = netlist.addNet(words[first]);
+            if (direction == "input") netlist.addInput(net);
+            if (direction == "output") netlist.addOutput(net);
+            return true;
+        }
+
+        const std::unordered_map<std::string, GateType>& primitives() {
+            static const std::unordered_map<std::string, GateType> table = {
+                {"buf", GateType::BUF}, {"not", GateType::NOT}, {"and", GateType::AND}, {"nand", GateType::NAND},
+                {"or", GateType::OR}, {"nor", GateType::NOR}, {"xor", GateType::XOR}, {"xnor", GateType::XNOR}};
+            return table;
+        }
+    }
+
+    bool ReadStructuralVerilog(std::istream& in, LogicNetlist& netlist) {
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        std::stringstream statements(stripComments(buffer.str()));
+
+        std::string statement;
+        int gateCounter = 0;
+        while (std::getline(statements, statement, ';')) {
+            statement = trim(statement);
+            if (statement.compare(0, 9, "endmodule") == 0) {
+                statement = trim(statement.substr(9));
+            }
+            if (statement.empty()) {
+                continue;
+            }
+
+            std::size_t keywordEnd = 0;
+            while (keywordEnd < statement.size() &&
+                   (std::isalnum(static_cast<unsigned char>(statement[keywordEnd])) || statement[keywordEnd] == '_')) {
+                ++keywordEnd;
+            }
+            std::string keyword = statement.substr(0, keywordEnd);
+            std::string rest = trim(statement.substr(keywordEnd));
+
+            if (keyword == "module") {
+                // Plain port lists get their directions from later declarations;
+                // ANSI headers ("module t(input a, output y)") declare them here
+                std::size_t open = rest.find('('), close = rest.rfind(')');
+                if (open == std::string::npos) {
+                    continue;
+                }
+                if (close == std::string::npos || close < open) {
+                    Logger::Log("Malformed module header: " + statement, LogLevel::ERROR);
+                    return false;
+                }
+                std::vector<std::string> ports = splitList(rest.substr(open + 1, close - open - 1));
+                std::string direction;
+                if (!ports.empty()) {
+                    std::string firstWord = ports[0].substr(0, ports[0].find_first_of(" \t"));
+                    if (firstWord == "input" || firstWord == "output" || firstWord == "inout") {
+                        for (const std::string& port : ports) {
+                            if (!declarePort(port, direction, netlist)) return false;
+                        }
+                    }
+                }
+                continue;
+            }
+            if (keyword == "input" || keyword == "output" || keyword == "wire") {
+                std::string direction = keyword == "wire" ? std::string() : keyword;
+                for (const std::string& name : splitList(rest)) {
+                    if (!declarePort(name, direction, netlist)) return false;
+                }
+                continue;
+            }
+
+            auto primitive = primitives().find(keyword);
+            std::size_t open = rest.find('(');
+            std::size_t close = rest.rfind(')');
+            if (primitive == primitives().end() || open == std::string::npos || close == std::string::npos || close < open) {
+                Logger::Log("Unsupported Verilog statement: " + statement, LogLevel::ERROR);
+                return false;
+            }
+
+            std::string header = trim(rest.substr(0, open));
+            std::string ports = rest.substr(open + 1, close - open - 1);
+            double delay = 1.0;
+            if (!header.empty() && header[0] == '#') {
+                // "#2 g1(" or "#(2) g1(" -- the parenthesised form puts the delay before `open`
+                if (header.size() == 1 && rest.size() > open) {
+                    std::size_t delayClose = rest.find(')', open);
+                    if (delayClose == std::string::npos || !parseDelay(rest.substr(open + 1, delayClose - open - 1), delay)) {
+                        Logger::Log("Malformed gate delay: " + statement, LogLevel::ERROR);
+                        return false;
+                    }
+                    rest = trim(rest.substr(delayClose + 1));
+                    open = rest.find('(');
+                    close = rest.rfind(')');
+                    if (open == std::string::npos || close == std::string::npos || close < open) {
+                        Logger::Log("Malformed gate instance: " + statement, LogLevel::ERROR);
+                        return false;
+                    }
+                    header = trim(rest.substr(0, open));
+                    ports = rest.substr(open + 1, close - open - 1);
+                } else {
+                    std::size_t delayEnd = 1;
+                    while (delayEnd < header.size() && !std::isspace(static_cast<unsigned char>(header[delayEnd]))) ++delayEnd;
+                    if (!parseDelay(header.substr(1, delayEnd - 1), delay)) {
+                        Logger::Log("Malformed gate delay: " + statement, LogLevel::ERROR);
+                        return false;
+                    }
+                    header = trim(header.substr(delayEnd));
+                }
+            }
+
+            std::vector<std::string> terminals = splitList(ports);
+            if (terminals.size() < 2) {
+                Logger::Log("Gate needs an output and at least one input: " + statement, LogLevel::ERROR);
+                return false;
+            }
+
+            std::vector<int> inputs;
+            for (std::size_t i = 1; i < terminals.size(); ++i) {
+                inputs.push_back(netlist.addNet(terminals[i]));
+            }
+            std::string name = header.empty() ? keyword + std::to_string(gateCounter) : header;
+            ++gateCounter;
+            netlist.addGate(name, primitive->second, inputs, netlist.addNet(terminals[0]), delay);
+        }
+
+        Logger::Log("Read structural Verilog: " + std::to_string(netlist.getGates().size()) + " gates, " +
+                    std::to_string(netlist.netCount()) + " nets");
+        return true;
+    }
+
+    bool ReadStructuralVerilogFile(const std::string& filename, LogicNetlist& netlist) {
+        std::ifstream file(filename);
+        if (!file) {
+            Logger::Log("Failed to open Verilog file: " + filename, LogLevel::ERROR);
+            return false;
+        }
+        return ReadStructuralVerilog(file, netlist);
+    }
+
+} // namespace Cathedral
@@ -0,0 +1,574 @@
+#include "simulation/job_scheduler.h"
+#include "core/circuit_hash.h"
+#include "parser/netlist_parser.h"
+#include "util/logging.h"
+#include "util/result_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <locale>
+#include <sstream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace Cathedral {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        double secondsBetween(Clock::time_point start, Clock::time_point end) {
+            return std::chrono::duration<double>(end - start).count();
+        }
+
+        const std::size_t kMaxErrorBytes = 64 * 1024;  // A crashing simulator can be very chatty on stderr
+
+        std::string reducedModelLine(const ReducedModel& model) {
+            return "reduced " + std::to_string(model.componentIds.size()) + " components, " +
+                   std::to_string(model.originalOrder) + " -> " + std::to_string(model.reducedOrder) +
+                   " unknowns, " + std::to_string(model.portNodes.size()) + " ports, error " +
+                   std::to_string(model.maxRelativeError);
+        }
+
+        std::string reductionFailureLine(const ReductionFailure& failure) {
+            std::string line = "failed to reduce " + std::to_string(failure.componentIds.size()) + " components";
+            if (failure.maxRelativeError >= 0.0) line += ", error " + std::to_string(failure.maxRelativeError);
+            return line;
+        }
+
+        // One error for the whole job; the per-subnetwork details are in the output lines
+        std::string reductionFailureText(const std::vector<ReductionFailure>& failures) {
+            std::size_t components = 0;
+            double worst = -1.0;
+            for (const ReductionFailure& failure : failures) {
+                components += failure.componentIds.size();
+                worst = std::max(worst, failure.maxRelativeError);
+            }
+            std::string text = std::to_string(failures.size()) + " linear subnetworks (" + std::to_string(components) +
+                               " components) could not be reduced within the error target";
+            if (worst >= 0.0) text += ", worst relative error " + std::to_string(worst);
+            return text;
+        }
+
+        std::string primaOptionsText(const PrimaOptions& options) {
+            std::ostringstream text;
+            text.imbue(std::locale::classic());
+            text << std::hexfloat << "prima s0=" << options.expansionFrequency << " blocks=" << options.maxBlockMoments
+                 << " target=" << options.targetError << " min=" << options.minInternalNodes << " gmin=" << options.gmin
+                 << " check=";
+            for (double frequency : options.checkFrequencies) {
+                text << frequency << ',';
+            }
+            return text.str();
+        }
+
+#ifndef _WIN32
+        // Close-on-exec so children started by other workers do not inherit these ends
+        bool openPipe(int fds[2]) {
+#ifdef __linux__
+            return pipe2(fds, O_CLOEXEC) == 0;
+#else
+            if (pipe(fds) != 0) return false;
+            fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+            fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+            return true;
+#endif
+        }
+#endif
+    }
+
+    const char* JobStatusName(JobStatus status) {
+        switch (status) {
+            case JobStatus::Queued: return "queued";
+            case JobStatus::Running: return "running";
+            case JobStatus::Succeeded: return "succeeded";
+            case JobStatus::Failed: return "failed";
+            case JobStatus::TimedOut: return "timed out";
+            case JobStatus::Cancelled: return "cancelled";
+        }
+        return "unknown";
+    }
+
+    JobContext::JobContext(std::uint64_t id, const JobLimits& limits, const std::atomic<bool>& cancelled,
+                           const std::function<void(const JobEvent&)>& listener, JobResult& result)
+        : id(id), jobLimits(limits), cancelled(cancelled), listener(listener), result(result),
+          hasDeadline(limits.timeoutSeconds > 0.0) {
+        deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                                      std::chrono::duration<double>(hasDeadline ? limits.timeoutSeconds : 0.0));
+    }
+
+    void JobContext::emit(const std::string& line) {
+        result.output += line;
+        result.output += '\n';
+        if (listener) {
+            listener({id, JobEvent::Kind::Output, JobStatus::Running, line});
+        }
+    }
+
+    void JobContext::fail(const std::string& message) {
+        result.error = message;
+    }
+
+    bool JobContext::shouldStop() const {
+        return cancelled.load(std::memory_order_relaxed) || (hasDeadline && Clock::now() >= deadline);
+    }
+
+    JobStatus JobContext::stopStatus() const {
+        return cancelled.load(std::memory_order_relaxed) ? JobStatus::Cancelled : JobStatus::TimedOut;
+    }
+
+    double JobContext::remainingSeconds() const {
+        if (!hasDeadline) return -1.0;
+        return std::max(0.0, secondsBetween(Clock::now(), deadline));
+    }
+
+    BuiltinBackend::BuiltinBackend(const PrimaOptions& options, std::shared_ptr<ResultCache> cache)
+        : options(options), optionsText(primaOptionsText(options)), cache(std::move(cache)) {}
+
+    JobStatus BuiltinBackend::run(const SimulationJob& job, JobContext& context) {
+        std::istringstream in(job.netlist);
+        std::vector<CircuitComponent> parts;
+        if (!ReadSpiceNetlist(in, parts)) {
+            context.fail("Netlist could not be parsed");
+            return JobStatus::Failed;
+        }
+        context.emit("components " + std::to_string(parts.size()));
+        if (context.shouldStop()) {
+            return context.stopStatus();
+        }
+
+        Circuit circuit;
+        circuit.addComponents(parts);
+        std::vector<ReductionFailure> failures;
+        if (!cache) {
+            for (const ReducedModel& model : ReduceLinearSubnetworks(circuit, {}, options, &failures)) {
+                context.emit(reducedModelLine(model));
+            }
+            for (const ReductionFailure& failure : failures) {
+                context.emit(reductionFailureLine(failure));
+            }
+            // The reduction itself cannot be interrupted; a late result still counts as a timeout
+            if (context.shouldStop()) {
+                return context.stopStatus();
+            }
+            if (!failures.empty()) {
+                context.fail(reductionFailureText(failures));
+                return JobStatus::Failed;
+            }
+            return JobStatus::Succeeded;
+        }
+
+        // Linear subnetworks never span two connected subcircuits, so reducing
+        // each one on its own gives the same models as reducing the whole circuit
+        std::vector<SubcircuitKey> subcircuits = HashSubcircuits(circuit, optionsText);
+        std::size_t hits = 0;
+        for (const SubcircuitKey& sub : subcircuits) {
+            std::string keyText = CircuitKeyText(sub.canonical, optionsText);
+            std::string lines;
+            if (cache->lookup(sub.key, keyText, lines)) {
+                ++hits;
+            } else {
+                std::vector<CircuitComponent> subParts;
+                subParts.reserve(sub.componentIds.size());
+                for (const std::string& id : sub.componentIds) {
+                    subParts.push_back(circuit.getComponents().at(id));
+                }
+                Circuit subCircuit;
+                subCircuit.addComponents(subParts);
+                const std::size_t failuresBefore = failures.size();
+                for (const ReducedModel& model : ReduceLinearSubnetworks(subCircuit, {}, options, &failures)) {
+                    lines += reducedModelLine(model);
+                    lines += '\n';
+                }
+                for (std::size_t i = failuresBefore; i < failures.size(); ++i) {
+                    lines += reductionFailureLine(failures[i]);
+                    lines += '\n';
+                }
+                // Only results that met the target are memoized; a failure is retried next time
+                if (failures.size() == failuresBefore) {
+                    cache->store(sub.key, keyText, lines);  // Complete even if the job is now past its deadline
+                }
+            }
+            std::istringstream stream(lines);
+            for (std::string line; std::getline(stream, line);) {
+                context.emit(line);
+            }
+            if (context.shouldStop()) {
+                return context.stopStatus();
+            }
+        }
+        context.emit("cached " + std::to_string(hits) + " of " + std::to_string(subcircuits.size()) + " subcircuits");
+        if (!failures.empty()) {
+            context.fail(reductionFailureText(failures));
+            return JobStatus::Failed;
+        }
+        return JobStatus::Succeeded;
+    }
+
+    ExternalSimulatorBackend::ExternalSimulatorBackend(std::vector<std::string> command)
+        : command(std::move(command)) {
+#ifndef _WIN32
+        // A simulator that exits before reading its netlist must not kill us with SIGPIPE;
+        // children get the default disposition back before exec
+        static std::once_flag ignorePipe;
+        std::call_once(ignorePipe, [] { std::signal(SIGPIPE, SIG_IGN); });
+#endif
+    }
+
+    std::string ExternalSimulatorBackend::name() const {
+        return command.empty() ? std::string("external") : command.front();
+    }
+
+#ifdef _WIN32
+    JobStatus ExternalSimulatorBackend::run(const SimulationJob&, JobContext& context) {
+        context.fail("External simulators are only supported on POSIX systems");
+        return JobStatus::Failed;
+    }
+#else
+    JobStatus ExternalSimulatorBackend::run(const SimulationJob& job, JobContext& context) {
+        if (command.empty()) {
+            context.fail("No simulator command configured");
+            return JobStatus::Failed;
+        }
+
+        std::vector<std::string> args = command;
+        std::string netlistFile;
+        for (std::string& arg : args) {
+            if (arg != "{netlist}") continue;
+            if (netlistFile.empty()) {
+                std::string pattern = (std::filesystem::temp_directory_path() / "cathedral-XXXXXX.cir").string();
+                int fd = mkstemps(pattern.data(), 4);
+                if (fd < 0) {
+                    context.fail("Failed to create a temporary netlist file");
+                    return JobStatus::Failed;
+                }
+                bool written = ::write(fd, job.netlist.data(), job.netlist.size()) == static_cast<ssize_t>(job.netlist.size());
+                ::close(fd);
+                netlistFile = pattern;
+                if (!written) {
+                    std::remove(netlistFile.c_str());
+                    context.fail("Failed to write the temporary netlist file");
+                    return JobStatus::Failed;
+                }
+            }
+            arg = netlistFile;
+        }
+        const bool netlistOnStdin = netlistFile.empty();
+        auto removeNetlistFile = [&netlistFile] {
+            if (!netlistFile.empty()) std::remove(netlistFile.c_str());
+        };
+
+        std::vector<char*> argv;
+        for (std::string& arg : args) argv.push_back(arg.data());
+        argv.push_back(nullptr);
+
+        int input[2] = {-1, -1}, output[2] = {-1, -1}, errors[2] = {-1, -1};
+        if (!openPipe(input) || !openPipe(output) || !openPipe(errors)) {
+            for (int fd : {input[0], input[1], output[0], output[1], errors[0], errors[1]}) {
+                if (fd >= 0) ::close(fd);
+            }
+            removeNetlistFile();
+            context.fail("Failed to create pipes for the simulator");
+            return JobStatus::Failed;
+        }
+
+        // Everything the child needs is prepared here: only async-signal-safe calls after fork()
+        const JobLimits& limits = context.limits();
+        struct rlimit memoryLimit = {static_cast<rlim_t>(limits.memoryBytes), static_cast<rlim_t>(limits.memoryBytes)};
+        rlim_t cpuSeconds = static_cast<rlim_t>(limits.timeoutSeconds) + 1;
+        struct rlimit cpuLimit = {cpuSeconds, cpuSeconds + 1};  // Backstop; the deadline below is what normally fires
+        struct sigaction defaultAction = {};
+        defaultAction.sa_handler = SIG_DFL;
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            dup2(input[0], STDIN_FILENO);
+            dup2(output[1], STDOUT_FILENO);
+            dup2(errors[1], STDERR_FILENO);
+            sigaction(SIGPIPE, &defaultAction, nullptr);
+            if (limits.memoryBytes > 0) setrlimit(RLIMIT_AS, &memoryLimit);
+            if (limits.timeoutSeconds > 0.0) setrlimit(RLIMIT_CPU, &cpuLimit);
+            execvp(argv[0], argv.data());
+            _exit(127);
+        }
+        ::close(input[0]);
+        ::close(output[1]);
+        ::close(errors[1]);
+        if (pid < 0) {
+            for (int fd : {input[1], output[0], errors[0]}) ::close(fd);
+            removeNetlistFile();
+            context.fail("Failed to start " + command.front());
+            return JobStatus::Failed;
+        }
+
+        int inputFd = input[1];
+        if (netlistOnStdin) {
+            fcntl(inputFd, F_SETFL, fcntl(inputFd, F_GETFL) | O_NONBLOCK);
+        } else {
+            ::close(inputFd);
+            inputFd = -1;
+        }
+        int outputFd = output[0], errorFd = errors[0];
+        std::size_t inputWritten = 0;
+        std::string pendingLine, errorText;
+        bool stopped = false;
+        char buffer[4096];
+
+        // Stream stdout line by line while feeding stdin, so neither side can block the other
+        while (outputFd >= 0 || errorFd >= 0) {
+            if (context.shouldStop()) {
+                stopped = true;
+                kill(pid, SIGKILL);
+                break;
+            }
+            pollfd fds[3];
+            int count = 0;
+            if (inputFd >= 0) fds[count++] = {inputFd, POLLOUT, 0};
+            if (outputFd >= 0) fds[count++] = {outputFd, POLLIN, 0};
+            if (errorFd >= 0) fds[count++] = {errorFd, POLLIN, 0};
+            double remaining = context.remainingSeconds();
+            int waitMs = remaining < 0.0 ? 100 : static_cast<int>(std::min(100.0, remaining * 1000.0 + 1.0));
+            if (poll(fds, count, waitMs) < 0 && errno != EINTR) {
+                break;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                if (fds[i].revents == 0) continue;
+                int fd = fds[i].fd;
+                if (fd == inputFd) {
+                    ssize_t n = ::write(fd, job.netlist.data() + inputWritten, job.netlist.size() - inputWritten);
+                    if (n > 0) inputWritten += static_cast<std::size_t>(n);
+                    if ((n < 0 && errno != EAGAIN && errno != EINTR) || inputWritten == job.netlist.size()) {
+                        ::close(inputFd);  // EOF tells the simulator the netlist is complete
+                        inputFd = -1;
+                    }
+                    continue;
+                }
+                ssize_t n = ::read(fd, buffer, sizeof(buffer));
+                if (n < 0 && (errno == EAGAIN || errno == EINTR)) continue;
+                if (n <= 0) {
+                    ::close(fd);
+                    (fd == outputFd ? outputFd : errorFd) = -1;
+                    continue;
+                }
+                if (fd == errorFd) {
+                    if (errorText.size() < kMaxErrorBytes) errorText.append(buffer, static_cast<std::size_t>(n));
+                    continue;
+                }
+                pendingLine.append(buffer, static_cast<std::size_t>(n));
+                std::size_t start = 0, newline;
+                while ((newline = pendingLine.find('\n', start)) != std::string::npos) {
+                    context.emit(pendingLine.substr(start, newline - start));
+                    start = newline + 1;
+                }
+                pendingLine.erase(0, start);
+            }
+        }
+        for (int fd : {inputFd, outputFd, errorFd}) {
+            if (fd >= 0) ::close(fd);
+        }
+        if (!stopped && !pendingLine.empty()) {
+            context.emit(pendingLine);
+        }
+
+        // The simulator may close its output and keep running; the deadline still applies
+        int status = 0;
+        while (waitpid(pid, &status, stopped ? 0 : WNOHANG) == 0) {
+            if (context.shouldStop()) {
+                stopped = true;
+                kill(pid, SIGKILL);
+                continue;
+            }
+            usleep(10000);
+        }
+        removeNetlistFile();
+
+        while (!errorText.empty() && (errorText.back() == '\n' || errorText.back() == '\r')) errorText.pop_back();
+        if (stopped) {
+            context.fail(context.stopStatus() == JobStatus::Cancelled ? "Cancelled" : "Time limit exceeded");
+            return context.stopStatus();
+        }
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            if (!errorText.empty()) context.fail(errorText);  // Warnings; the job still succeeded
+            return JobStatus::Succeeded;
+        }
+        if (WIFSIGNALED(status) && WTERMSIG(status) == SIGXCPU) {
+            context.fail("CPU time limit exceeded");
+            return JobStatus::TimedOut;
+        }
+        std::string reason = WIFEXITED(status) ? (WEXITSTATUS(status) == 127 ? "could not be started"
+                                                  : "exited with status " + std::to_string(WEXITSTATUS(status)))
+                                               : "was killed by signal " + std::to_string(WTERMSIG(status));
+        context.fail(command.front() + " " + reason + (errorText.empty() ? "" : ": " + errorText));
+        return JobStatus::Failed;
+    }
+#endif
+
+    JobScheduler::JobScheduler(std::shared_ptr<SimulationBackend> backend, int workerCount)
+        : backend(std::move(backend)) {
+        if (workerCount <= 0) {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workers.reserve(workerCount);
+        for (int i = 0; i < workerCount; ++i) {
+            workers.emplace_back(&JobScheduler::workerLoop, this);
+        }
+    }
+
+    JobScheduler::~JobScheduler() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            for (auto& entry : active) {
+                entry.second->cancelled = true;
+            }
+        }
+        workAvailable.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+    void JobScheduler::setListener(Listener newListener) {
+        std::lock_guard<std::mutex> lock(mutex);
+        listener = std::move(newListener);
+    }
+
+    std::uint64_t JobScheduler::submit(SimulationJob job) {
+        auto state = std::make_shared<JobState>();
+        state->job = std::move(job);
+        std::uint64_t id;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            id = nextId++;
+            state->id = id;
+            state->submitted = Clock::now();
+            if (!windowOpen) {
+                firstSubmit = state->submitted;
+                windowOpen = true;
+            }
+            ++totals.submitted;
+            active.emplace(id, state);
+            queue.push({state->job.priority, id, state});
+        }
+        workAvailable.notify_one();
+        return id;
+    }
+
+    bool JobScheduler::cancel(std::uint64_t id) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = active.find(id);
+        if (it == active.end()) {
+            return false;
+        }
+        // Queued jobs are skipped when a worker pops them; running ones see it through JobContext
+        it->second->cancelled = true;
+        return true;
+    }
+
+    void JobScheduler::cancelAll() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : active) {
+            entry.second->cancelled = true;
+        }
+    }
+
+    void JobScheduler::waitAll() {
+        std::unique_lock<std::mutex> lock(mutex);
+        allDone.wait(lock, [this] { return queue.empty() && running == 0; });
+    }
+
+    std::vector<JobResult> JobScheduler::takeResults() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<JobResult> finished;
+        finished.swap(results);
+        return finished;
+    }
+
+    SchedulerStats JobScheduler::stats() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        SchedulerStats snapshot = totals;
+        if (windowOpen && snapshot.completed() > 0) {
+            snapshot.wallSeconds = secondsBetween(firstSubmit, lastFinish);
+        }
+        return snapshot;
+    }
+
+    void JobScheduler::resetStats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        totals = SchedulerStats();
+        windowOpen = false;
+    }
+
+    void JobScheduler::workerLoop() {
+        for (;;) {
+            std::shared_ptr<JobState> state;
+            Listener notify;
+            Clock::time_point dequeued;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                workAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) {
+                    return;  // Stopping and drained
+                }
+                state = queue.top().state;
+                queue.pop();
+                ++running;
+                notify = listener;
+                dequeued = Clock::now();
+            }
+
+            JobResult result;
+            result.id = state->id;
+            result.name = state->job.name;
+            result.queueSeconds = secondsBetween(state->submitted, dequeued);
+            result.status = JobStatus::Cancelled;
+            if (!state->cancelled) {
+                if (notify) {
+                    notify({state->id, JobEvent::Kind::Started, JobStatus::Running, state->job.name});
+                }
+                JobContext context(state->id, state->job.limits, state->cancelled, notify, result);
+                auto start = Clock::now();
+                result.status = backend->run(state->job, context);
+                result.runSeconds = secondsBetween(start, Clock::now());
+            }
+            JobEvent finished{state->id, JobEvent::Kind::Finished, result.status,
+                              result.error.empty() ? state->job.name : result.error};
+
+            // Recorded before the Finished event so a listener reading stats() sees this job
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                switch (result.status) {
+                    case JobStatus::Succeeded: ++totals.succeeded; break;
+                    case JobStatus::TimedOut: ++totals.timedOut; break;
+                    case JobStatus::Cancelled: ++totals.cancelled; break;
+                    default: ++totals.failed; break;
+                }
+                totals.busySeconds += result.runSeconds;
+                totals.queueSeconds += result.queueSeconds;
+                lastFinish = Clock::now();
+                totals.overheadSeconds += secondsBetween(dequeued, lastFinish) - result.runSeconds;
+                active.erase(state->id);
+                results.push_back(std::move(result));
+            }
+            if (notify) {
+                notify(finished);
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                --running;
+                if (queue.empty() && running == 0) {
+                    allDone.notify_all();
+                }
+            }
+        }
+    }
+
+} // namespace Cathedral
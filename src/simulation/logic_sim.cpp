@@ -0,0 +1,370 @@
+#include "simulation/logic_sim.h"
+#include "util/alloc_counter.h"
+#include "util/logging.h"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+
+namespace Cathedral {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        double secondsSince(Clock::time_point start) {
+            return std::chrono::duration<double>(Clock::now() - start).count();
+        }
+
+        bool isInverting(GateType type) {
+            return type == GateType::NOT || type == GateType::NAND || type == GateType::NOR || type == GateType::XNOR;
+        }
+    }
+
+    int LogicNetlist::addNet(const std::string& name) {
+        auto it = netIndex.find(name);
+        if (it != netIndex.end()) {
+            return it->second;
+        }
+        int index = static_cast<int>(netNames.size());
+        netNames.push_back(name);
+        netIndex[name] = index;
+        return index;
+    }
+
+    int LogicNetlist::findNet(const std::string& name) const {
+        auto it = netIndex.find(name);
+        return it == netIndex.end() ? -1 : it->second;
+    }
+
+    void LogicNetlist::addInput(int net) {
+        inputs.push_back(net);
+    }
+
+    void LogicNetlist::addOutput(int net) {
+        outputs.push_back(net);
+    }
+
+    void LogicNetlist::addGate(const std::string& name, GateType type, const std::vector<int>& gateInputs, int output, double delay) {
+        gates.push_back({name, type, gateInputs, output, delay});
+    }
+
+    bool LogicNetlist::levelize(std::vector<int>& order, std::vector<int>& levels) const {
+        const int nets = netCount();
+        std::vector<int> driver(nets, -1);
+        for (int g = 0; g < static_cast<int>(gates.size()); ++g) {
+            int out = gates[g].output;
+            if (driver[out] != -1) {
+                Logger::Log("Net " + netNames[out] + " has multiple drivers", LogLevel::ERROR);
+                return false;
+            }
+            driver[out] = g;
+        }
+
+        // Kahn's algorithm over gates: a gate is ready once all its input nets are settled
+        std::vector<int> pending(gates.size(), 0);
+        std::vector<std::vector<int>> readers(nets);
+        for (int g = 0; g < static_cast<int>(gates.size()); ++g) {
+            for (int in : gates[g].inputs) {
+                readers[in].push_back(g);
+                if (driver[in] != -1) {
+                    ++pending[g];
+                }
+            }
+        }
+
+        std::vector<int> netLevel(nets, 0);
+        levels.assign(gates.size(), 0);
+        order.clear();
+        order.reserve(gates.size());
+        for (int g = 0; g < static_cast<int>(gates.size()); ++g) {
+            if (pending[g] == 0) {
+                order.push_back(g);
+            }
+        }
+        for (std::size_t head = 0; head < order.size(); ++head) {
+            int g = order[head];
+            int level = 0;
+            for (int in : gates[g].inputs) {
+                level = std::max(level, netLevel[in]);
+            }
+            levels[g] = level + 1;
+            netLevel[gates[g].output] = level + 1;
+            for (int reader : readers[gates[g].output]) {
+                if (--pending[reader] == 0) {
+                    order.push_back(reader);
+                }
+            }
+        }
+
+        if (order.size() != gates.size()) {
+            Logger::Log("Combinational loop detected; " + std::to_string(gates.size() - order.size()) +
+                        " gates could not be levelized", LogLevel::ERROR);
+            return false;
+        }
+
+        // Stable sort by level so each level is a contiguous run of the program
+        std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return levels[a] < levels[b]; });
+        return true;
+    }
+
+    CompiledLogicSim::CompiledLogicSim(const LogicNetlist& netlist, int blockWords)
+        : blockWords(std::max(1, blockWords)),
+          netTotal(netlist.netCount()),
+          inputNets(netlist.getInputs()),
+          outputNets(netlist.getOutputs()) {
+        std::vector<int> order, levels;
+        if (!netlist.levelize(order, levels)) {
+            return;
+        }
+
+        const auto& gates = netlist.getGates();
+        program.reserve(order.size());
+        for (int g : order) {
+            const LogicGate& gate = gates[g];
+            if (gate.inputs.empty() || gate.inputs.size() > 255) {
+                Logger::Log("Gate " + gate.name + " has an unsupported input count", LogLevel::ERROR);
+                return;
+            }
+            Instruction instr;
+            instr.op = gate.type;
+            instr.inputCount = static_cast<std::uint8_t>(gate.inputs.size());
+            instr.output = gate.output;
+            instr.firstOperand = static_cast<int>(operands.size());
+            operands.insert(operands.end(), gate.inputs.begin(), gate.inputs.end());
+            program.push_back(instr);
+        }
+
+        firstReader.assign(netTotal, static_cast<int>(program.size()));
+        for (int i = static_cast<int>(program.size()) - 1; i >= 0; --i) {
+            for (int k = 0; k < program[i].inputCount; ++k) {
+                firstReader[operands[program[i].firstOperand + k]] = i;
+            }
+        }
+
+        goodValues.assign(static_cast<std::size_t>(netTotal) * this->blockWords, 0);
+        faultValues.assign(goodValues.size(), 0);
+        compiled = true;
+        Logger::Log("Compiled logic netlist: " + std::to_string(program.size()) + " instructions, " +
+                    std::to_string(netTotal) + " nets, " + std::to_string(patternsPerBlock()) + " patterns per pass");
+    }
+
+    void CompiledLogicSim::loadInputs(const std::vector<PatternWord>& inputs, std::vector<PatternWord>& values) const {
+        std::fill(values.begin(), values.end(), 0);
+        for (std::size_t i = 0; i < inputNets.size(); ++i) {
+            for (int w = 0; w < blockWords; ++w) {
+                std::size_t src = i * blockWords + w;
+                values[static_cast<std::size_t>(inputNets[i]) * blockWords + w] = src < inputs.size() ? inputs[src] : 0;
+            }
+        }
+    }
+
+    void CompiledLogicSim::run(std::vector<PatternWord>& values, std::size_t first, int skipOutput) const {
+        const int W = blockWords;
+        PatternWord* base = values.data();
+        for (std::size_t i = first; i < program.size(); ++i) {
+            const Instruction& instr = program[i];
+            if (instr.output == skipOutput) {
+                continue;
+            }
+            PatternWord* out = base + static_cast<std::size_t>(instr.output) * W;
+            const int* ops = operands.data() + instr.firstOperand;
+            const PatternWord* a = base + static_cast<std::size_t>(ops[0]) * W;
+            for (int w = 0; w < W; ++w) {
+                out[w] = a[w];
+            }
+            for (int k = 1; k < instr.inputCount; ++k) {
+                const PatternWord* b = base + static_cast<std::size_t>(ops[k]) * W;
+                switch (instr.op) {
+                    case GateType::AND:
+                    case GateType::NAND:
+                        for (int w = 0; w < W; ++w) out[w] &= b[w];
+                        break;
+                    case GateType::OR:
+                    case GateType::NOR:
+                        for (int w = 0; w < W; ++w) out[w] |= b[w];
+                        break;
+                    case GateType::XOR:
+                    case GateType::XNOR:
+                        for (int w = 0; w < W; ++w) out[w] ^= b[w];
+                        break;
+                    default:
+                        break;  // BUF/NOT only use their first input
+                }
+            }
+            if (isInverting(instr.op)) {
+                for (int w = 0; w < W; ++w) out[w] = ~out[w];
+            }
+        }
+    }
+
+    void CompiledLogicSim::simulate(const std::vector<PatternWord>& inputs, std::vector<PatternWord>& outputs) {
+        outputs.assign(outputNets.size() * blockWords, 0);
+        if (!compiled) {
+            return;
+        }
+
+        auto start = Clock::now();
+        loadInputs(inputs, goodValues);
+        run(goodValues, 0, -1);
+        for (std::size_t o = 0; o < outputNets.size(); ++o) {
+            std::copy_n(goodValues.begin() + static_cast<std::size_t>(outputNets[o]) * blockWords, blockWords,
+                        outputs.begin() + o * blockWords);
+        }
+        simStats.gateEvaluations += program.size() * static_cast<std::uint64_t>(patternsPerBlock());
+        simStats.seconds += secondsSince(start);
+    }
+
+    void CompiledLogicSim::simulateFaults(const std::vector<PatternWord>& inputs, const std::vector<StuckAtFault>& faults,
+                                          std::vector<PatternWord>& detected) {
+        detected.assign(faults.size() * blockWords, 0);
+        if (!compiled) {
+            return;
+        }
+
+        auto start = Clock::now();
+        std::uint64_t evaluated = program.size();
+        loadInputs(inputs, goodValues);
+        run(goodValues, 0, -1);
+
+        for (std::size_t f = 0; f < faults.size(); ++f) {
+            SteadyStateCheck steadyState("stuck-at fault simulation");
+            const StuckAtFault& fault = faults[f];
+            if (fault.net < 0 || fault.net >= netTotal) {
+                continue;
+            }
+            faultValues = goodValues;  // Same size every fault, so this copies without reallocating
+            std::fill_n(faultValues.begin() + static_cast<std::size_t>(fault.net) * blockWords, blockWords,
+                        fault.stuckValue ? ~PatternWord(0) : PatternWord(0));
+
+            // Only the fanout side of the fault site can differ from the good machine
+            std::size_t first = static_cast<std::size_t>(firstReader[fault.net]);
+            run(faultValues, first, fault.net);
+            evaluated += program.size() - first;
+
+            PatternWord* mask = detected.data() + f * blockWords;
+            for (int out : outputNets) {
+                const PatternWord* good = goodValues.data() + static_cast<std::size_t>(out) * blockWords;
+                const PatternWord* bad = faultValues.data() + static_cast<std::size_t>(out) * blockWords;
+                for (int w = 0; w < blockWords; ++w) {
+                    mask[w] |= good[w] ^ bad[w];
+                }
+            }
+        }
+
+        simStats.gateEvaluations += evaluated * static_cast<std::uint64_t>(patternsPerBlock());
+        simStats.seconds += secondsSince(start);
+    }
+
+    std::vector<StuckAtFault> CompiledLogicSim::allStuckAtFaults(const LogicNetlist& netlist) {
+        std::vector<StuckAtFault> faults;
+        faults.reserve(static_cast<std::size_t>(netlist.netCount()) * 2);
+        for (int net = 0; net < netlist.netCount(); ++net) {
+            faults.push_back({net, false});
+            faults.push_back({net, true});
+        }
+        return faults;
+    }
+
+    EventLogicSim::EventLogicSim(const LogicNetlist& netlist)
+        : gates(netlist.getGates()) {
+        const int nets = netlist.netCount();
+        fanoutStart.assign(nets + 1, 0);
+        for (const LogicGate& gate : gates) {
+            for (int in : gate.inputs) {
+                ++fanoutStart[in + 1];
+            }
+        }
+        for (int n = 0; n < nets; ++n) {
+            fanoutStart[n + 1] += fanoutStart[n];
+        }
+        fanoutGates.resize(fanoutStart[nets]);
+        std::vector<int> fill(fanoutStart.begin(), fanoutStart.end() - 1);
+        for (int g = 0; g < static_cast<int>(gates.size()); ++g) {
+            for (int in : gates[g].inputs) {
+                fanoutGates[fill[in]++] = g;
+            }
+        }
+
+        isOutput.assign(nets, 0);
+        for (int out : netlist.getOutputs()) {
+            isOutput[out] = 1;
+        }
+
+        // Settle the all-zero input state with zero delay so time 0 starts consistent
+        values.assign(nets, 0);
+        std::vector<int> order, levels;
+        if (netlist.levelize(order, levels)) {
+            for (int g : order) {
+                values[gates[g].output] = evaluate(g);
+            }
+        }
+        projected = values;
+    }
+
+    std::uint8_t EventLogicSim::evaluate(int gate) const {
+        const LogicGate& g = gates[gate];
+        std::uint8_t v = g.inputs.empty() ? 0 : values[g.inputs[0]];
+        for (std::size_t k = 1; k < g.inputs.size(); ++k) {
+            std::uint8_t b = values[g.inputs[k]];
+            switch (g.type) {
+                case GateType::AND:
+                case GateType::NAND:
+                    v &= b;
+                    break;
+                case GateType::OR:
+                case GateType::NOR:
+                    v |= b;
+                    break;
+                case GateType::XOR:
+                case GateType::XNOR:
+                    v ^= b;
+                    break;
+                default:
+                    break;
+            }
+        }
+        return isInverting(g.type) ? v ^ 1 : v;
+    }
+
+    void EventLogicSim::schedule(double time, int net, std::uint8_t value) {
+        if (projected[net] == value) {
+            return;
+        }
+        projected[net] = value;
+        queue.push_back({time, sequence++, net, value});
+        std::push_heap(queue.begin(), queue.end(), std::greater<Event>());
+    }
+
+    void EventLogicSim::setInput(int net, bool value, double time) {
+        // Stimulus may arrive out of time order, so `projected` (which assumes
+        // monotonic scheduling per net) cannot filter it; run() drops no-op edges.
+        queue.push_back({std::max(time, now), sequence++, net, static_cast<std::uint8_t>(value ? 1 : 0)});
+        std::push_heap(queue.begin(), queue.end(), std::greater<Event>());
+    }
+
+    void EventLogicSim::run(double until) {
+        auto start = Clock::now();
+        while (!queue.empty() && queue.front().time <= until) {
+            std::pop_heap(queue.begin(), queue.end(), std::greater<Event>());
+            Event event = queue.back();
+            queue.pop_back();
+
+            now = event.time;
+            if (values[event.net] == event.value) {
+                continue;
+            }
+            values[event.net] = event.value;
+            if (isOutput[event.net]) {
+                trace.push_back({now, event.net, event.value != 0});
+            }
+
+            for (int i = fanoutStart[event.net]; i < fanoutStart[event.net + 1]; ++i) {
+                int g = fanoutGates[i];
+                ++simStats.gateEvaluations;
+                schedule(now + gates[g].delay, gates[g].output, evaluate(g));
+            }
+        }
+        now = std::max(now, until);
+        simStats.seconds += secondsSince(start);
+    }
+
+} // namespace Cathedral
@@ -0,0 +1,593 @@
+#include "simulation/model_reduction.h"
+#include "core/arena.h"
+#include "util/alloc_counter.h"
+#include "util/logging.h"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <numeric>
+#include <set>
+
+namespace Cathedral {
+
+    namespace {
+        const double kPi = 3.14159265358979323846;
+
+        bool isLinearType(const std::string& type) {
+            return type == "Resistor" || type == "Capacitor" || type == "Inductor";
+        }
+
+        struct Triplet {
+            int row, col;
+            double value;
+        };
+
+        // Compressed sparse rows; duplicate triplets are summed
+        struct SparseMatrix {
+            int size = 0;
+            std::vector<int> rowStart;
+            std::vector<int> cols;
+            std::vector<double> values;
+
+            SparseMatrix(int n, std::vector<Triplet> triplets) : size(n), rowStart(n + 1, 0) {
+                std::sort(triplets.begin(), triplets.end(), [](const Triplet& a, const Triplet& b) {
+                    return a.row != b.row ? a.row < b.row : a.col < b.col;
+                });
+                int lastRow = -1;
+                for (const Triplet& t : triplets) {
+                    if (t.row == lastRow && cols.back() == t.col) {
+                        values.back() += t.value;
+                        continue;
+                    }
+                    cols.push_back(t.col);
+                    values.push_back(t.value);
+                    lastRow = t.row;
+                    rowStart[t.row + 1] = static_cast<int>(cols.size());
+                }
+                for (int i = 0; i < n; ++i) {
+                    rowStart[i + 1] = std::max(rowStart[i + 1], rowStart[i]);
+                }
+            }
+
+            void multiply(const double* x, double* y) const {
+                for (int i = 0; i < size; ++i) {
+                    double sum = 0.0;
+                    for (int k = rowStart[i]; k < rowStart[i + 1]; ++k) {
+                        sum += values[k] * x[cols[k]];
+                    }
+                    y[i] = sum;
+                }
+            }
+        };
+
+        // LU without pivoting over a symmetric envelope (skyline) profile. MNA
+        // matrices of R/C/L networks have a positive (semi)definite symmetric part,
+        // so elimination in the given order is stable once gmin keeps nodes regular.
+        template <typename T>
+        class SkylineLU {
+        public:
+            explicit SkylineLU(const std::vector<int>& firstColumn) : first(firstColumn), offset(firstColumn.size() + 1, 0) {
+                for (std::size_t i = 0; i < first.size(); ++i) {
+                    offset[i + 1] = offset[i] + (i - first[i] + 1);
+                }
+                lower.assign(offset.back(), T(0));
+                upper.assign(offset.back(), T(0));
+            }
+
+            void add(int row, int col, T value) {
+                if (row > col) {
+                    lower[offset[row] + col - first[row]] += value;
+                } else {
+                    upper[offset[col] + row - first[col]] += value;
+                }
+            }
+
+            bool factor() {
+                const int n = static_cast<int>(first.size());
+                for (int i = 0; i < n; ++i) {
+                    const int fi = first[i];
+                    T* Li = &lower[offset[i]];
+                    T* Ui = &upper[offset[i]];
+                    for (int j = fi; j < i; ++j) {
+                        const int fj = first[j];
+                        const T* Lj = &lower[offset[j]];
+                        const T* Uj = &upper[offset[j]];
+                        T su = Ui[j - fi];
+                        T sl = Li[j - fi];
+                        for (int k = std::max(fi, fj); k < j; ++k) {
+                            su -= Lj[k - fj] * Ui[k - fi];
+                            sl -= Li[k - fi] * Uj[k - fj];
+                        }
+                        Ui[j - fi] = su;
+                        Li[j - fi] = sl / Uj[j - fj];
+                    }
+                    T diag = Ui[i - fi];
+                    for (int k = fi; k < i; ++k) {
+                        diag -= Li[k - fi] * Ui[k - fi];
+                    }
+                    if (std::abs(diag) == 0.0) {
+                        return false;
+                    }
+                    Ui[i - fi] = diag;
+                }
+                return true;
+            }
+
+            void solve(std::vector<T>& x) const {
+                solve(x.data());
+            }
+
+            void solve(T* x) const {
+                const int n = static_cast<int>(first.size());
+                for (int i = 0; i < n; ++i) {
+                    const T* Li = &lower[offset[i]];
+                    T sum = x[i];
+                    for (int j = first[i]; j < i; ++j) {
+                        sum -= Li[j - first[i]] * x[j];
+                    }
+                    x[i] = sum;
+                }
+                for (int i = n - 1; i >= 0; --i) {
+                    const T* Ui = &upper[offset[i]];
+                    x[i] /= Ui[i - first[i]];
+                    for (int j = first[i]; j < i; ++j) {
+                        x[j] -= Ui[j - first[i]] * x[i];
+                    }
+                }
+            }
+
+        private:
+            std::vector<int> first;
+            std::vector<std::size_t> offset;
+            std::vector<T> lower;  // Row i, columns first[i]..i-1 (unit diagonal implied)
+            std::vector<T> upper;  // Column i, rows first[i]..i
+        };
+
+        // Reverse Cuthill-McKee ordering; keeps the skyline envelope narrow for
+        // the mesh- and tree-like graphs typical of extracted parasitics.
+        std::vector<int> reverseCuthillMcKee(const std::vector<std::vector<int>>& adjacency) {
+            const int n = static_cast<int>(adjacency.size());
+            std::vector<int> byDegree(n);
+            std::iota(byDegree.begin(), byDegree.end(), 0);
+            auto degreeLess = [&](int a, int b) { return adjacency[a].size() < adjacency[b].size(); };
+            std::stable_sort(byDegree.begin(), byDegree.end(), degreeLess);
+
+            std::vector<int> order;
+            order.reserve(n);
+            std::vector<char> visited(n, 0);
+            std::vector<int> neighbours;
+            for (int start : byDegree) {
+                if (visited[start]) {
+                    continue;
+                }
+                visited[start] = 1;
+                order.push_back(start);
+                for (std::size_t head = order.size() - 1; head < order.size(); ++head) {
+                    neighbours.clear();
+                    for (int next : adjacency[order[head]]) {
+                        if (!visited[next]) {
+                            visited[next] = 1;
+                            neighbours.push_back(next);
+                        }
+                    }
+                    std::stable_sort(neighbours.begin(), neighbours.end(), degreeLess);
+                    order.insert(order.end(), neighbours.begin(), neighbours.end());
+                }
+            }
+            std::reverse(order.begin(), order.end());
+            return order;
+        }
+
+        double dot(const double* a, const double* b, int n) {
+            double sum = 0.0;
+            for (int i = 0; i < n; ++i) {
+                sum += a[i] * b[i];
+            }
+            return sum;
+        }
+
+        // Dense complex solve with partial pivoting: A is n x n, rhs is n x m (row-major)
+        bool solveDense(std::complex<double>* A, std::complex<double>* rhs, int n, int m) {
+            for (int k = 0; k < n; ++k) {
+                int pivot = k;
+                for (int i = k + 1; i < n; ++i) {
+                    if (std::abs(A[i * n + k]) > std::abs(A[pivot * n + k])) pivot = i;
+                }
+                if (std::abs(A[pivot * n + k]) == 0.0) {
+                    return false;
+                }
+                if (pivot != k) {
+                    for (int j = 0; j < n; ++j) std::swap(A[k * n + j], A[pivot * n + j]);
+                    for (int j = 0; j < m; ++j) std::swap(rhs[k * m + j], rhs[pivot * m + j]);
+                }
+                for (int i = k + 1; i < n; ++i) {
+                    std::complex<double> factor = A[i * n + k] / A[k * n + k];
+                    if (factor == 0.0) continue;
+                    for (int j = k; j < n; ++j) A[i * n + j] -= factor * A[k * n + j];
+                    for (int j = 0; j < m; ++j) rhs[i * m + j] -= factor * rhs[k * m + j];
+                }
+            }
+            for (int i = n - 1; i >= 0; --i) {
+                for (int j = 0; j < m; ++j) {
+                    std::complex<double> sum = rhs[i * m + j];
+                    for (int k = i + 1; k < n; ++k) sum -= A[i * n + k] * rhs[k * m + j];
+                    rhs[i * m + j] = sum / A[i * n + i];
+                }
+            }
+            return true;
+        }
+
+        // Z = B^T (G + sC)^-1 B of a reduced model into Z (ports x ports); A and X come from `scratch`
+        void reducedImpedance(const ReducedModel& model, double frequency, MonotonicArena& scratch, std::complex<double>* Z) {
+            const int q = model.reducedOrder;
+            const int p = static_cast<int>(model.portNodes.size());
+            std::fill(Z, Z + p * p, std::complex<double>(0.0));
+            if (q == 0) {
+                return;
+            }
+            const std::complex<double> s(0.0, 2.0 * kPi * frequency);
+            std::complex<double>* A = scratch.allocateArray<std::complex<double>>(q * q);
+            std::complex<double>* X = scratch.allocateArray<std::complex<double>>(q * p);
+            for (int i = 0; i < q * q; ++i) {
+                A[i] = model.G[i] + s * model.C[i];
+            }
+            std::copy(model.B.begin(), model.B.end(), X);
+            if (!solveDense(A, X, q, p)) {
+                return;
+            }
+            for (int i = 0; i < p; ++i) {
+                for (int j = 0; j < p; ++j) {
+                    std::complex<double> sum = 0.0;
+                    for (int k = 0; k < q; ++k) sum += model.B[k * p + i] * X[k * p + j];
+                    Z[i * p + j] = sum;
+                }
+            }
+        }
+
+        // Full MNA system of a linear subnetwork, ordered for a narrow skyline
+        struct LinearSystem {
+            int order = 0;
+            std::vector<Triplet> G, C;
+            std::vector<int> first;       // Skyline profile
+            std::vector<int> portRows;    // Unknown index of each port voltage
+        };
+
+        bool buildSystem(const std::vector<const CircuitComponent*>& parts, const std::vector<int>& portNodes,
+                         const PrimaOptions& options, LinearSystem& system) {
+            std::map<int, int> nodeIndex;
+            for (const CircuitComponent* part : parts) {
+                for (int node : {part->node1, part->node2}) {
+                    if (node != 0) nodeIndex.emplace(node, 0);
+                }
+            }
+            int n = 0;
+            for (auto& entry : nodeIndex) {
+                entry.second = n++;
+            }
+
+            std::vector<std::vector<int>> adjacency(n);
+            std::vector<Triplet> G, C;
+            std::vector<std::pair<int, int>> inductorNodes;
+            auto index = [&](int node) { return node == 0 ? -1 : nodeIndex[node]; };
+            auto stamp = [](std::vector<Triplet>& M, int a, int b, double value) {
+                if (a >= 0) M.push_back({a, a, value});
+                if (b >= 0) M.push_back({b, b, value});
+                if (a >= 0 && b >= 0) {
+                    M.push_back({a, b, -value});
+                    M.push_back({b, a, -value});
+                }
+            };
+
+            for (const CircuitComponent* part : parts) {
+                int a = index(part->node1), b = index(part->node2);
+                if (a >= 0 && b >= 0 && a != b) {
+                    adjacency[a].push_back(b);
+                    adjacency[b].push_back(a);
+                }
+                if (part->type == "Resistor") {
+                    if (part->value <= 0.0) {
+                        Logger::Log("Resistor " + part->id + " has a non-positive value", LogLevel::ERROR);
+                        return false;
+                    }
+                    stamp(G, a, b, 1.0 / part->value);
+                } else if (part->type == "Capacitor") {
+                    stamp(C, a, b, part->value);
+                } else if (part->type == "Inductor") {
+                    int row = n + static_cast<int>(inductorNodes.size());
+                    inductorNodes.push_back({a, b});
+                    if (a >= 0) { G.push_back({a, row, 1.0}); G.push_back({row, a, -1.0}); }
+                    if (b >= 0) { G.push_back({b, row, -1.0}); G.push_back({row, b, 1.0}); }
+                    C.push_back({row, row, part->value});
+                }
+            }
+            for (int i = 0; i < n; ++i) {
+                G.push_back({i, i, options.gmin});
+            }
+
+            // Node voltages in RCM order, inductor currents last so their zero
+            // DC pivots are only reached after the Schur complement fills them in
+            std::vector<int> rcm = reverseCuthillMcKee(adjacency);
+            std::vector<int> position(n + inductorNodes.size());
+            for (int i = 0; i < n; ++i) position[rcm[i]] = i;
+            for (std::size_t k = 0; k < inductorNodes.size(); ++k) position[n + k] = n + static_cast<int>(k);
+            for (Triplet& t : G) { t.row = position[t.row]; t.col = position[t.col]; }
+            for (Triplet& t : C) { t.row = position[t.row]; t.col = position[t.col]; }
+
+            system.order = n + static_cast<int>(inductorNodes.size());
+            system.first.resize(system.order);
+            std::iota(system.first.begin(), system.first.end(), 0);
+            for (const auto* M : {&G, &C}) {
+                for (const Triplet& t : *M) {
+                    int low = std::min(t.row, t.col), high = std::max(t.row, t.col);
+                    system.first[high] = std::min(system.first[high], low);
+                }
+            }
+            system.G = std::move(G);
+            system.C = std::move(C);
+
+            system.portRows.clear();
+            for (int port : portNodes) {
+                auto it = nodeIndex.find(port);
+                if (port == 0 || it == nodeIndex.end()) {
+                    Logger::Log("Port node " + std::to_string(port) + " is not part of the linear network", LogLevel::ERROR);
+                    return false;
+                }
+                system.portRows.push_back(position[it->second]);
+            }
+            return true;
+        }
+
+        // Port impedance of the full system: column j is the response to a unit current into port j
+        bool fullImpedance(const LinearSystem& system, double frequency, std::vector<std::complex<double>>& Z) {
+            const std::complex<double> s(0.0, 2.0 * kPi * frequency);
+            SkylineLU<std::complex<double>> lu(system.first);
+            for (const Triplet& t : system.G) lu.add(t.row, t.col, t.value);
+            for (const Triplet& t : system.C) lu.add(t.row, t.col, s * t.value);
+            if (!lu.factor()) {
+                return false;
+            }
+            const std::size_t p = system.portRows.size();
+            Z.assign(p * p, 0.0);
+            std::vector<std::complex<double>> x;
+            for (std::size_t j = 0; j < p; ++j) {
+                x.assign(system.order, 0.0);
+                x[system.portRows[j]] = 1.0;
+                lu.solve(x);
+                for (std::size_t i = 0; i < p; ++i) {
+                    Z[i * p + j] = x[system.portRows[i]];
+                }
+            }
+            return true;
+        }
+
+        bool reduceComponents(const std::vector<const CircuitComponent*>& parts, const std::vector<int>& portNodes,
+                              const PrimaOptions& options, ReducedModel& model) {
+            LinearSystem system;
+            if (!buildSystem(parts, portNodes, options, system)) {
+                return false;
+            }
+            const int N = system.order;
+            const int p = static_cast<int>(system.portRows.size());
+
+            model = ReducedModel();
+            model.portNodes = portNodes;
+            model.originalOrder = N;
+            for (const CircuitComponent* part : parts) {
+                model.componentIds.push_back(part->id);
+            }
+            if (p == 0) {
+                Logger::Log("Linear network has no ports; nothing to reduce", LogLevel::WARNING);
+                return false;
+            }
+
+            const double s0 = 2.0 * kPi * options.expansionFrequency;
+            SkylineLU<double> lu(system.first);
+            for (const Triplet& t : system.G) lu.add(t.row, t.col, t.value);
+            for (const Triplet& t : system.C) lu.add(t.row, t.col, s0 * t.value);
+            if (!lu.factor()) {
+                Logger::Log("PRIMA: singular system at the expansion point", LogLevel::ERROR);
+                return false;
+            }
+            SparseMatrix G(N, system.G), C(N, system.C);
+
+            std::vector<std::vector<std::complex<double>>> reference;
+            for (double f : options.checkFrequencies) {
+                reference.emplace_back();
+                if (!fullImpedance(system, f, reference.back())) {
+                    Logger::Log("PRIMA: full model is singular at " + std::to_string(f) + " Hz", LogLevel::ERROR);
+                    return false;
+                }
+            }
+
+            // Block Arnoldi on A = (G + s0 C)^-1 C starting from R = (G + s0 C)^-1 B.
+            // Everything the moment loop touches is sized here: basis vectors come
+            // from a pool and the error check from scratch, so moments never hit the heap.
+            // The Krylov space cannot outgrow the full system, so neither can the budget
+            const int maxOrder = std::min(std::max(options.maxBlockMoments, 0) * p, N);
+            const std::size_t checkBytes = sizeof(std::complex<double>) * (maxOrder * (maxOrder + p) + p * p);
+            AnalysisMemory memory(checkBytes + 4 * alignof(std::max_align_t));
+            BlockPool& vectors = memory.pool(N * sizeof(double));
+            vectors.reserve(3 * maxOrder + 2 * p);  // V, GV, CV plus the current and next block
+            std::vector<double*> V, GV, CV, block, next;
+            for (auto* basis : {&V, &GV, &CV}) basis->reserve(maxOrder);
+            block.reserve(p);
+            next.reserve(p);
+            model.G.reserve(maxOrder * maxOrder);
+            model.C.reserve(maxOrder * maxOrder);
+            model.B.reserve(maxOrder * p);
+
+            for (int j = 0; j < p; ++j) {
+                double* r = vectors.allocateAs<double>();
+                std::fill(r, r + N, 0.0);
+                r[system.portRows[j]] = 1.0;
+                lu.solve(r);
+                block.push_back(r);
+            }
+
+            for (int moment = 0; moment < options.maxBlockMoments && !block.empty() &&
+                                 static_cast<int>(V.size()) + static_cast<int>(block.size()) <= maxOrder; ++moment) {
+                SteadyStateCheck steadyState("PRIMA block Arnoldi");
+                next.clear();
+                for (double* w : block) {
+                    const double initial = std::sqrt(dot(w, w, N));
+                    for (int pass = 0; pass < 2; ++pass) {  // Re-orthogonalise once for stability
+                        for (const double* v : V) {
+                            double h = dot(v, w, N);
+                            for (int i = 0; i < N; ++i) w[i] -= h * v[i];
+                        }
+                    }
+                    double norm = std::sqrt(dot(w, w, N));
+                    if (norm <= 1e-12 * initial || norm == 0.0) {
+                        vectors.deallocate(w);
+                        continue;  // Deflated: column adds nothing new to the Krylov space
+                    }
+                    for (int i = 0; i < N; ++i) w[i] /= norm;
+                    V.push_back(w);
+                    GV.push_back(vectors.allocateAs<double>());
+                    G.multiply(w, GV.back());
+                    CV.push_back(vectors.allocateAs<double>());
+                    C.multiply(w, CV.back());
+                    next.push_back(vectors.allocateAs<double>());
+                    std::copy(CV.back(), CV.back() + N, next.back());
+                    lu.solve(next.back());
+                }
+                block.swap(next);
+
+                const int q = static_cast<int>(V.size());
+                model.reducedOrder = q;
+                model.G.assign(q * q, 0.0);
+                model.C.assign(q * q, 0.0);
+                model.B.assign(q * p, 0.0);
+                for (int i = 0; i < q; ++i) {
+                    for (int j = 0; j < q; ++j) {
+                        model.G[i * q + j] = dot(V[i], GV[j], N);
+                        model.C[i * q + j] = dot(V[i], CV[j], N);
+                    }
+                    for (int j = 0; j < p; ++j) {
+                        model.B[i * p + j] = V[i][system.portRows[j]];
+                    }
+                }
+
+                if (reference.empty()) {
+                    continue;
+                }
+                double error = 0.0;
+                for (std::size_t f = 0; f < reference.size(); ++f) {
+                    MonotonicArena& scratch = memory.scratch();
+                    scratch.reset();
+                    std::complex<double>* Zr = scratch.allocateArray<std::complex<double>>(p * p);
+                    reducedImpedance(model, options.checkFrequencies[f], scratch, Zr);
+                    double scale = 0.0, diff = 0.0;
+                    for (int k = 0; k < p * p; ++k) {
+                        scale = std::max(scale, std::abs(reference[f][k]));
+                        diff = std::max(diff, std::abs(reference[f][k] - Zr[k]));
+                    }
+                    error = std::max(error, scale > 0.0 ? diff / scale : diff);
+                }
+                model.maxRelativeError = error;
+                if (error <= options.targetError) {
+                    break;
+                }
+            }
+
+            Logger::Log("PRIMA reduced " + std::to_string(N) + " unknowns to " + std::to_string(model.reducedOrder) +
+                        " (" + std::to_string(p) + " ports), max relative error " + std::to_string(model.maxRelativeError));
+            // Written so that a NaN error (e.g. from a degenerate network) also fails
+            if (!reference.empty() && !(model.maxRelativeError <= options.targetError)) {
+                Logger::Log("PRIMA target error " + std::to_string(options.targetError) + " not reached at order " +
+                            std::to_string(model.reducedOrder) + "; model rejected", LogLevel::WARNING);
+                return false;
+            }
+            return true;
+        }
+    }
+
+    std::vector<std::complex<double>> ReducedModel::impedance(double frequency) const {
+        const std::size_t p = portNodes.size();
+        std::vector<std::complex<double>> Z(p * p, 0.0);
+        MonotonicArena scratch(sizeof(std::complex<double>) * reducedOrder * (reducedOrder + p) + 64);
+        reducedImpedance(*this, frequency, scratch, Z.data());
+        return Z;
+    }
+
+    bool ReduceLinearNetwork(const Circuit& circuit, const std::vector<int>& portNodes,
+                             const PrimaOptions& options, ReducedModel& model) {
+        std::vector<const CircuitComponent*> parts;
+        for (const auto& [id, component] : circuit.getComponents()) {
+            if (isLinearType(component.type)) {
+                parts.push_back(&component);
+            }
+        }
+        std::sort(parts.begin(), parts.end(), [](const CircuitComponent* a, const CircuitComponent* b) { return a->id < b->id; });
+        return reduceComponents(parts, portNodes, options, model);
+    }
+
+    std::vector<ReducedModel> ReduceLinearSubnetworks(const Circuit& circuit, const std::vector<int>& externalNodes,
+                                                      const PrimaOptions& options,
+                                                      std::vector<ReductionFailure>* failures) {
+        std::map<int, int> parent;
+        auto find = [&](int node) {
+            int root = node;
+            while (parent[root] != root) root = parent[root];
+            while (parent[node] != root) { int up = parent[node]; parent[node] = root; node = up; }
+            return root;
+        };
+        auto touch = [&](int node) { parent.emplace(node, node); };
+
+        std::set<int> portCandidates(externalNodes.begin(), externalNodes.end());
+        std::vector<const CircuitComponent*> linear;
+        for (const auto& [id, component] : circuit.getComponents()) {
+            if (!isLinearType(component.type)) {
+                portCandidates.insert(component.node1);
+                portCandidates.insert(component.node2);
+                continue;
+            }
+            if (component.node1 == 0 && component.node2 == 0) {
+                continue;
+            }
+            linear.push_back(&component);
+            for (int node : {component.node1, component.node2}) {
+                if (node != 0) touch(node);
+            }
+            if (component.node1 != 0 && component.node2 != 0) {
+                parent[find(component.node1)] = find(component.node2);
+            }
+        }
+        std::sort(linear.begin(), linear.end(), [](const CircuitComponent* a, const CircuitComponent* b) { return a->id < b->id; });
+
+        std::map<int, std::vector<const CircuitComponent*>> groups;
+        for (const CircuitComponent* part : linear) {
+            groups[find(part->node1 != 0 ? part->node1 : part->node2)].push_back(part);
+        }
+
+        std::vector<ReducedModel> models;
+        for (const auto& [root, parts] : groups) {
+            std::set<int> nodes;
+            for (const CircuitComponent* part : parts) {
+                if (part->node1 != 0) nodes.insert(part->node1);
+                if (part->node2 != 0) nodes.insert(part->node2);
+            }
+            std::vector<int> ports;
+            for (int node : nodes) {
+                if (portCandidates.count(node)) ports.push_back(node);
+            }
+            int internal = static_cast<int>(nodes.size() - ports.size());
+            if (ports.empty() || internal < options.minInternalNodes) {
+                continue;
+            }
+            ReducedModel model;
+            if (!reduceComponents(parts, ports, options, model)) {
+                if (failures) {
+                    ReductionFailure failure;
+                    for (const CircuitComponent* part : parts) failure.componentIds.push_back(part->id);
+                    failure.maxRelativeError = model.reducedOrder > 0 ? model.maxRelativeError : -1.0;
+                    failures->push_back(std::move(failure));
+                }
+            } else if (model.reducedOrder < model.originalOrder) {
+                models.push_back(std::move(model));
+            }
+        }
+        return models;
+    }
+
+} // namespace Cathedral
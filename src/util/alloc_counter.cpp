@@ -0,0 +1,71 @@
+#include "util/alloc_counter.h"
+#include "util/logging.h"
+#include <cstdlib>
+#include <new>
+
+namespace Cathedral {
+
+#ifdef CATHEDRAL_COUNT_ALLOCATIONS
+    namespace {
+        // Plain integer so touching it never allocates or runs a dynamic initialiser
+        thread_local std::uint64_t allocationCount = 0;
+    }
+
+    std::uint64_t ThreadAllocationCount() { return allocationCount; }
+    bool AllocationCountingEnabled() { return true; }
+
+    void CountAllocation() { ++allocationCount; }
+#else
+    std::uint64_t ThreadAllocationCount() { return 0; }
+    bool AllocationCountingEnabled() { return false; }
+#endif
+
+    void ReportSteadyStateAllocation(const char* loop, std::uint64_t allocations) {
+        Logger::Log(std::string("Steady-state iteration of ") + loop + " made " + std::to_string(allocations) +
+                    " heap allocation(s)", LogLevel::ERROR);
+        std::abort();
+    }
+
+} // namespace Cathedral
+
+#ifdef CATHEDRAL_COUNT_ALLOCATIONS
+// Replacement global allocation functions; everything else forwards to these
+// or to the aligned overloads below.
+namespace {
+    void* countedAllocate(std::size_t size) {
+        Cathedral::CountAllocation();
+        if (void* memory = std::malloc(size ? size : 1)) return memory;
+        throw std::bad_alloc();
+    }
+
+    void* countedAllocate(std::size_t size, std::align_val_t alignment) {
+        Cathedral::CountAllocation();
+        std::size_t align = static_cast<std::size_t>(alignment);
+        std::size_t rounded = (size + align - 1) / align * align;
+        if (void* memory = std::aligned_alloc(align, rounded ? rounded : align)) return memory;
+        throw std::bad_alloc();
+    }
+}
+
+void* operator new(std::size_t size) { return countedAllocate(size); }
+void* operator new[](std::size_t size) { return countedAllocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try { return countedAllocate(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) { return countedAllocate(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return countedAllocate(size, alignment); }
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { std::free(memory); }
+void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+#endif
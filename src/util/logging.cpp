@@ -3,14 +3,28 @@
 namespace Cathedral {
 
     std::ofstream Logger::logFile;
+    Logger::Sink Logger::sink;
+    LogLevel Logger::consoleLevel = LogLevel::INFO;
+    std::mutex Logger::mutex;
 
     void Logger::SetLogFile(const std::string& filename) {
+        std::lock_guard<std::mutex> lock(mutex);
         logFile.open(filename, std::ios::out | std::ios::app);
         if (!logFile) {
             std::cerr << "[ERROR] Failed to open log file: " << filename << std::endl;
         }
     }
 
+    void Logger::SetSink(Sink newSink) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sink = std::move(newSink);
+    }
+
+    void Logger::SetConsoleLevel(LogLevel minimum) {
+        std::lock_guard<std::mutex> lock(mutex);
+        consoleLevel = minimum;
+    }
+
     std::string Logger::LogLevelToString(LogLevel level) {
         switch (level) {
             case LogLevel::INFO: return "INFO";
@@ -22,13 +36,20 @@ namespace Cathedral {
 
     void Logger::Log(const std::string& message, LogLevel level) {
         std::string output = "[" + LogLevelToString(level) + "] " + message;
+        std::lock_guard<std::mutex> lock(mutex);
 
         // Print to console
-        std::cout << output << std::endl;
+        if (level >= consoleLevel) {
+            std::cout << output << std::endl;
+        }
 
         // Write to log file if open
         if (logFile.is_open()) {
             logFile << output << std::endl;
         }
+
+        if (sink) {
+            sink(message, level);
+        }
     }
 }
@@ -0,0 +1,205 @@
+#include "util/result_cache.h"
+#include "util/logging.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace Cathedral {
+
+    namespace {
+        const char* kResultExtension = ".result";
+
+        // Entry layout: "<key hex> <key text bytes>\n<key text><result>"
+        std::string entryHeader(const CircuitKey& key, const std::string& keyText) {
+            return key.toHex() + " " + std::to_string(keyText.size()) + "\n" + keyText;
+        }
+
+        long processId() {
+#ifdef _WIN32
+            return _getpid();
+#else
+            return static_cast<long>(getpid());
+#endif
+        }
+
+        bool isShardDirectory(const fs::path& path) {
+            std::string name = path.filename().string();
+            return name.size() == 2 && std::isxdigit(static_cast<unsigned char>(name[0])) &&
+                   std::isxdigit(static_cast<unsigned char>(name[1]));
+        }
+    }
+
+    ResultCache::ResultCache(const std::string& directory, std::uintmax_t maxBytes)
+        : directory(directory), maxBytes(maxBytes) {
+        std::error_code ec;
+        fs::create_directories(directory, ec);
+        if (ec) {
+            Logger::Log("Failed to create result cache directory: " + directory, LogLevel::ERROR);
+            return;
+        }
+        for (const auto& entry : fs::recursive_directory_iterator(directory, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == kResultExtension) {
+                totalBytes += entry.file_size(ec);
+            }
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        evictToLimit();
+    }
+
+    std::string ResultCache::pathFor(const CircuitKey& key) const {
+        std::string hex = key.toHex();
+        return (fs::path(directory) / hex.substr(0, 2) / (hex + kResultExtension)).string();
+    }
+
+    // File I/O runs unlocked: entries only ever appear through an atomic rename,
+    // so the mutex guards just the counters and the size bookkeeping.
+    bool ResultCache::lookup(const CircuitKey& key, const std::string& keyText, std::string& result) {
+        std::string path = pathFor(key);
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            ++misses;
+            return false;
+        }
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        std::string entry = contents.str();
+        std::string header = entryHeader(key, keyText);
+        if (entry.compare(0, header.size(), header) != 0) {
+            Logger::Log("Result cache entry does not match its key, ignoring: " + path, LogLevel::WARNING);
+            ++misses;
+            return false;
+        }
+        result = entry.substr(header.size());
+
+        std::error_code ec;
+        fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+        ++hits;
+        return true;
+    }
+
+    std::uintmax_t ResultCache::sizeBytes() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return totalBytes;
+    }
+
+    bool ResultCache::store(const CircuitKey& key, const std::string& keyText, const std::string& result) {
+        fs::path path = pathFor(key);
+        // Per process and thread, so concurrent writers of one key never share a temp file
+        fs::path temp = path;
+        temp += "." + std::to_string(processId()) + "-" +
+                std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+        std::string header = entryHeader(key, keyText);
+
+        std::error_code ec;
+        fs::create_directories(path.parent_path(), ec);
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file || !file.write(header.data(), static_cast<std::streamsize>(header.size())) ||
+                !file.write(result.data(), static_cast<std::streamsize>(result.size()))) {
+                Logger::Log("Failed to write cache entry: " + temp.string(), LogLevel::ERROR);
+                file.close();
+                fs::remove(temp, ec);
+                return false;
+            }
+        }
+
+        std::uintmax_t previous = fs::file_size(path, ec);
+        if (ec) previous = 0;
+        // Rename is atomic, so concurrent readers never see a partial entry
+        fs::rename(temp, path, ec);
+        if (ec) {
+            Logger::Log("Failed to commit cache entry: " + path.string(), LogLevel::ERROR);
+            fs::remove(temp, ec);
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        totalBytes = totalBytes - std::min(totalBytes, previous) + header.size() + result.size();
+        evictToLimit();
+        return true;
+    }
+
+    void ResultCache::clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::error_code ec;
+        for (const auto& shard : fs::directory_iterator(directory, ec)) {
+            if (!shard.is_directory(ec) || !isShardDirectory(shard.path())) {
+                continue;
+            }
+            std::vector<fs::path> entries;
+            for (const auto& entry : fs::directory_iterator(shard.path(), ec)) {
+                if (entry.is_regular_file(ec) && entry.path().extension() == kResultExtension) {
+                    entries.push_back(entry.path());
+                }
+            }
+            for (const fs::path& entry : entries) {
+                fs::remove(entry, ec);
+            }
+            fs::remove(shard.path(), ec);  // Only succeeds once the shard is empty
+        }
+        totalBytes = 0;
+    }
+
+    std::string ResultCache::getOrCompute(const CircuitKey& key, const std::string& keyText,
+                                          const std::function<std::string()>& compute) {
+        std::string result;
+        if (lookup(key, keyText, result)) {
+            return result;
+        }
+        result = compute();
+        store(key, keyText, result);
+        return result;
+    }
+
+    void ResultCache::evictToLimit() {
+        if (totalBytes <= maxBytes) {
+            return;
+        }
+
+        struct Entry {
+            fs::path path;
+            fs::file_time_type time;
+            std::uintmax_t size;
+        };
+        std::vector<Entry> entries;
+        std::error_code ec;
+        for (const auto& entry : fs::recursive_directory_iterator(directory, ec)) {
+            if (entry.is_regular_file(ec) && entry.path().extension() == kResultExtension) {
+                entries.push_back({entry.path(), entry.last_write_time(ec), entry.file_size(ec)});
+            }
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+
+        // Rescanning also corrects any drift from entries removed behind our back
+        totalBytes = 0;
+        for (const Entry& entry : entries) {
+            totalBytes += entry.size;
+        }
+        // Evict down to a low-water mark so a full cache is not rescanned on every store
+        const std::uintmax_t target = maxBytes - maxBytes / 10;
+        std::size_t evicted = 0;
+        for (const Entry& entry : entries) {
+            if (totalBytes <= target) {
+                break;
+            }
+            if (fs::remove(entry.path, ec)) {
+                totalBytes -= entry.size;
+                ++evicted;
+            }
+        }
+        Logger::Log("Result cache evicted " + std::to_string(evicted) + " entries, " +
+                    std::to_string(totalBytes) + " bytes remain");
+    }
+
+} // namespace Cathedral
@@ -0,0 +1,132 @@
+// Circuit keys and the on-disk result cache: key stability, entry
+// verification, eviction, and subcircuit reuse across unrelated edits.
+#include "core/circuit_hash.h"
+#include "parser/netlist_parser.h"
+#include "util/result_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+namespace fs = std::filesystem;
+using namespace Cathedral;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    Circuit parse(const std::string& netlist) {
+        std::istringstream in(netlist);
+        std::vector<CircuitComponent> parts;
+        expect(ReadSpiceNetlist(in, parts), "netlist parses");
+        Circuit circuit;
+        circuit.addComponents(parts);
+        return circuit;
+    }
+
+    std::vector<CircuitKey> sortedKeys(const std::vector<SubcircuitKey>& subcircuits) {
+        std::vector<CircuitKey> keys;
+        for (const SubcircuitKey& sub : subcircuits) keys.push_back(sub.key);
+        std::sort(keys.begin(), keys.end(), [](const CircuitKey& a, const CircuitKey& b) { return a.toHex() < b.toHex(); });
+        return keys;
+    }
+
+    void testKeyIndependence() {
+        Circuit a;
+        a.addComponent("Resistor", 1e3, 1, 2);
+        a.addComponent("Capacitor", 1e-12, 2, 0);
+        Circuit b;  // Same parts, other IDs, other order, resistor terminals swapped
+        b.addComponent("Capacitor", 1e-12, 2, 0);
+        b.addComponent("Capacitor", 5.0, 7, 7);
+        b.removeComponent("Capacitor1");
+        b.addComponent("Resistor", 1e3, 2, 1);
+        expect(HashCircuit(a, "tran") == HashCircuit(b, "tran"), "key ignores IDs and order");
+        expect(HashCircuit(a, "tran") != HashCircuit(a, "ac"), "key depends on the options");
+
+        Circuit c;
+        c.addComponent("Resistor", 1e3 * (1.0 + 1e-15), 1, 2);
+        c.addComponent("Capacitor", 1e-12, 2, 0);
+        expect(HashCircuit(a, "tran") != HashCircuit(c, "tran"), "key sees a one-ulp value change");
+    }
+
+    void testSubcircuitReuse() {
+        const std::string groups =
+            "R1 in mid 1k\n"
+            "C1 mid 0 1p\n"
+            "R2 a b 2k\n"
+            "C2 b 0 2p\n";
+        Circuit before = parse("two RC groups\n" + groups);
+        // An unrelated part with a new named node renumbers every later net
+        Circuit after = parse("two RC groups and one more\nRn new 0 1k\n" + groups);
+
+        std::vector<CircuitKey> old = sortedKeys(HashSubcircuits(before, "prima"));
+        std::vector<CircuitKey> edited = sortedKeys(HashSubcircuits(after, "prima"));
+        expect(old.size() == 2 && edited.size() == 3, "one key per connected group");
+        int reused = 0;
+        for (const CircuitKey& key : old) {
+            if (std::find(edited.begin(), edited.end(), key) != edited.end()) ++reused;
+        }
+        expect(reused == 2, "unchanged groups keep their keys after an unrelated edit");
+    }
+
+    void testEntryVerification(const fs::path& directory) {
+        ResultCache cache(directory.string());
+        CircuitKey key{1, 2};
+        std::string result;
+        expect(!cache.lookup(key, "text A", result), "empty cache misses");
+        expect(cache.store(key, "text A", "payload\n"), "store succeeds");
+        expect(cache.lookup(key, "text A", result) && result == "payload\n", "stored entry is served");
+        expect(!cache.lookup(key, "text B", result), "same key with other key text is a miss");
+        expect(cache.getHits() == 1 && cache.getMisses() == 2, "hits and misses are counted");
+
+        std::ofstream(directory / "notes.txt") << "not a cache entry";
+        cache.clear();
+        expect(!cache.lookup(key, "text A", result), "clear removes entries");
+        expect(fs::exists(directory / "notes.txt"), "clear leaves other files alone");
+        expect(cache.sizeBytes() == 0, "clear resets the size");
+    }
+
+    void testEviction(const fs::path& directory) {
+        const std::uintmax_t limit = 64 * 1024;
+        ResultCache cache(directory.string(), limit);
+        const std::string payload(4096, 'x');
+        const int entries = 64;  // About four times the limit
+        for (int i = 0; i < entries; ++i) {
+            cache.store(CircuitKey{0, static_cast<std::uint64_t>(i)}, "key " + std::to_string(i), payload);
+        }
+        expect(cache.sizeBytes() <= limit, "size stays within the limit");
+
+        std::uintmax_t onDisk = 0;
+        for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+            if (entry.path().extension() == ".result") onDisk += entry.file_size();
+        }
+        expect(onDisk == cache.sizeBytes(), "tracked size matches the files on disk");
+
+        std::string result;
+        int last = entries - 1;
+        expect(cache.lookup(CircuitKey{0, static_cast<std::uint64_t>(last)}, "key " + std::to_string(last), result),
+               "most recent entry survives eviction");
+    }
+}
+
+int main() {
+    std::random_device seed;
+    fs::path root = fs::temp_directory_path() / ("cathedral_result_cache_" + std::to_string(seed()));
+
+    testKeyIndependence();
+    testSubcircuitReuse();
+    testEntryVerification(root / "verify");
+    testEviction(root / "evict");
+
+    fs::remove_all(root);
+    if (failures == 0) std::printf("result_cache: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
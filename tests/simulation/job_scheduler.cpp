@@ -0,0 +1,190 @@
+// Job scheduler end to end: ExternalSimulatorBackend driving tools/fake_simulator
+// through every way a simulator run can end, and BuiltinBackend with the
+// result cache. The fake simulator's path is the first argument.
+#include "simulation/job_scheduler.h"
+#include "util/logging.h"
+#include "util/result_cache.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace fs = std::filesystem;
+using namespace Cathedral;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    bool contains(const std::string& text, const std::string& part) {
+        return text.find(part) != std::string::npos;
+    }
+
+    SimulationJob makeJob(const std::string& directive, double timeoutSeconds = 10.0, std::uint64_t memoryBytes = 0) {
+        SimulationJob job;
+        job.name = directive.empty() ? "plain" : directive;
+        job.netlist = "fake run\nR1 1 2 1k\nC1 2 0 1p\n";
+        if (!directive.empty()) job.netlist += "* fake: " + directive + "\n";
+        job.netlist += ".end\n";
+        job.limits.timeoutSeconds = timeoutSeconds;
+        job.limits.memoryBytes = memoryBytes;
+        return job;
+    }
+
+    JobResult runOne(JobScheduler& scheduler, SimulationJob job) {
+        scheduler.submit(std::move(job));
+        scheduler.waitAll();
+        std::vector<JobResult> results = scheduler.takeResults();
+        expect(results.size() == 1, "one result per job");
+        return results.empty() ? JobResult() : results.front();
+    }
+
+    std::string ladder(int stages, const char* firstResistor) {
+        std::string netlist = "RC ladder\nV1 1 0 1\n";
+        for (int stage = 1; stage <= stages; ++stage) {
+            netlist += "R" + std::to_string(stage) + " " + std::to_string(stage) + " " + std::to_string(stage + 1) + " " +
+                       (stage == 1 ? firstResistor : "1k") + "\n";
+            netlist += "C" + std::to_string(stage) + " " + std::to_string(stage + 1) + " 0 1p\n";
+        }
+        return netlist + ".end\n";
+    }
+
+#ifndef _WIN32
+    void testExternalOutcomes(const std::string& simulator) {
+        JobScheduler scheduler(std::make_shared<ExternalSimulatorBackend>(std::vector<std::string>{simulator}), 2);
+
+        JobResult ok = runOne(scheduler, makeJob(""));
+        expect(ok.status == JobStatus::Succeeded, "plain run succeeds");
+        expect(ok.output == "elements 2\nnodes 3\ndone\n", "output is streamed line by line");
+
+        auto start = std::chrono::steady_clock::now();
+        JobResult hung = runOne(scheduler, makeJob("hang", 0.3));
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        expect(hung.status == JobStatus::TimedOut, "hanging simulator times out");
+        expect(hung.error == "Time limit exceeded", "timeout is reported");
+        expect(seconds < 5.0, "hanging simulator is killed at the deadline");
+
+        JobResult greedy = runOne(scheduler, makeJob("alloc 512", 10.0, 64ull << 20));
+        expect(greedy.status == JobStatus::Failed, "RLIMIT_AS stops a greedy simulator");
+        expect(contains(greedy.error, "killed by signal"), "allocation failure is reported as a crash");
+
+        JobResult failed = runOne(scheduler, makeJob("fail"));
+        expect(failed.status == JobStatus::Failed, "non-zero exit fails the job");
+        expect(contains(failed.error, "exited with status 1") && contains(failed.error, "failure requested"),
+               "exit status and stderr are reported");
+        expect(contains(failed.output, "elements 2"), "output before the failure is kept");
+
+        JobResult crashed = runOne(scheduler, makeJob("crash"));
+        expect(crashed.status == JobStatus::Failed, "crash fails the job");
+        expect(contains(crashed.error, "killed by signal"), "crash signal is reported");
+
+        JobScheduler fileScheduler(
+            std::make_shared<ExternalSimulatorBackend>(std::vector<std::string>{simulator, "{netlist}"}), 1);
+        JobResult fromFile = runOne(fileScheduler, makeJob(""));
+        expect(fromFile.status == JobStatus::Succeeded && contains(fromFile.output, "done"),
+               "netlist can be passed as a temporary file");
+    }
+
+    void testCancellation(const std::string& simulator) {
+        JobScheduler scheduler(std::make_shared<ExternalSimulatorBackend>(std::vector<std::string>{simulator}), 1);
+        std::atomic<bool> started{false};
+        scheduler.setListener([&started](const JobEvent& event) {
+            if (event.kind == JobEvent::Kind::Started) started = true;
+        });
+
+        std::uint64_t running = scheduler.submit(makeJob("hang", 0.0));
+        std::uint64_t queued = scheduler.submit(makeJob("hang", 0.0));
+        for (int i = 0; i < 500 && !started; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        expect(started, "first job starts");
+        expect(scheduler.cancel(queued), "queued job can be cancelled");
+        expect(scheduler.cancel(running), "running job can be cancelled");
+        scheduler.waitAll();
+
+        std::vector<JobResult> results = scheduler.takeResults();
+        expect(results.size() == 2, "cancelled jobs still report results");
+        for (const JobResult& result : results) {
+            expect(result.status == JobStatus::Cancelled, "cancelled job ends as Cancelled");
+        }
+        expect(!scheduler.cancel(running), "finished job cannot be cancelled again");
+        SchedulerStats stats = scheduler.stats();
+        expect(stats.cancelled == 2 && stats.completed() == 2, "stats count cancellations");
+    }
+
+    void testMissingBinary() {
+        JobScheduler scheduler(
+            std::make_shared<ExternalSimulatorBackend>(std::vector<std::string>{"/nonexistent/cathedral-simulator"}), 1);
+        JobResult missing = runOne(scheduler, makeJob(""));
+        expect(missing.status == JobStatus::Failed, "missing simulator fails the job");
+        expect(contains(missing.error, "could not be started"), "missing simulator is reported");
+    }
+#endif
+
+    void testBuiltinWithCache(const fs::path& directory) {
+        auto cache = std::make_shared<ResultCache>(directory.string());
+        JobScheduler scheduler(std::make_shared<BuiltinBackend>(PrimaOptions(), cache), 2);
+
+        SimulationJob job;
+        job.name = "ladder";
+        job.netlist = ladder(24, "1k");
+        JobResult first = runOne(scheduler, job);
+        expect(first.status == JobStatus::Succeeded, "ladder reduces to spec");
+        expect(contains(first.output, "\nreduced 48 components"), "ladder is reduced as one model");
+        expect(contains(first.output, "cached 0 of 1 subcircuits"), "first run computes");
+
+        JobResult second = runOne(scheduler, job);
+        expect(second.status == JobStatus::Succeeded, "cached run succeeds");
+        expect(contains(second.output, "cached 1 of 1 subcircuits"), "second run is served from the cache");
+        expect(first.output.substr(0, first.output.find("cached")) == second.output.substr(0, second.output.find("cached")),
+               "cached models match the computed ones");
+
+        // A 0 ohm resistor cannot be stamped: the job fails and nothing is cached
+        SimulationJob shorted;
+        shorted.name = "shorted";
+        shorted.netlist = ladder(24, "0");
+        JobResult broken = runOne(scheduler, shorted);
+        expect(broken.status == JobStatus::Failed, "unreducible subnetwork fails the job");
+        expect(contains(broken.error, "could not be reduced"), "reduction failure is reported");
+        expect(contains(broken.output, "failed to reduce"), "failed subnetwork is listed in the output");
+        JobResult retried = runOne(scheduler, shorted);
+        expect(retried.status == JobStatus::Failed && contains(retried.output, "cached 0 of 1 subcircuits"),
+               "failed reductions are not cached");
+
+        JobScheduler uncached(std::make_shared<BuiltinBackend>(), 1);
+        expect(runOne(uncached, shorted).status == JobStatus::Failed, "failure propagates without a cache too");
+    }
+}
+
+int main(int argc, char** argv) {
+    Logger::SetConsoleLevel(LogLevel::ERROR);  // The failure cases log warnings by design
+#ifndef _WIN32
+    if (argc < 2) {
+        std::printf("usage: job_scheduler <path to fake_simulator>\n");
+        return 1;
+    }
+    testExternalOutcomes(argv[1]);
+    testCancellation(argv[1]);
+    testMissingBinary();
+#else
+    (void)argc;
+    (void)argv;
+#endif
+
+    std::random_device seed;
+    fs::path root = fs::temp_directory_path() / ("cathedral_job_scheduler_" + std::to_string(seed()));
+    testBuiltinWithCache(root);
+
+    fs::remove_all(root);
+    if (failures == 0) std::printf("job_scheduler: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
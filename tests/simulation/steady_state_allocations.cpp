@@ -0,0 +1,102 @@
+// Runs the hot loops guarded by SteadyStateCheck -- PRIMA block Arnoldi and
+// stuck-at fault simulation -- in a CATHEDRAL_COUNT_ALLOCATIONS build. Any heap
+// allocation inside a steady-state iteration aborts the process, which fails
+// the test; the checks below cover the results themselves.
+#include "core/circuit.h"
+#include "simulation/logic_sim.h"
+#include "simulation/model_reduction.h"
+#include "util/alloc_counter.h"
+#include <cmath>
+#include <cstdio>
+#include <memory>
+
+using namespace Cathedral;
+
+namespace {
+    int failures = 0;
+
+    void expect(bool condition, const char* what) {
+        if (!condition) {
+            std::printf("FAILED: %s\n", what);
+            ++failures;
+        }
+    }
+
+    void testCountingIsActive() {
+        std::uint64_t before = ThreadAllocationCount();
+        auto probe = std::make_unique<int>(1);
+        expect(AllocationCountingEnabled(), "built with CATHEDRAL_COUNT_ALLOCATIONS");
+        expect(ThreadAllocationCount() > before, "operator new is counted");
+    }
+
+    void testPrimaReduction() {
+        // 40-stage RC ladder driven at node 1 and observed at the far end
+        const int stages = 40;
+        std::vector<CircuitComponent> parts;
+        for (int i = 1; i <= stages; ++i) {
+            parts.push_back({"", "Resistor", 1e3, i, i + 1});
+            parts.push_back({"", "Capacitor", 1e-12, i + 1, 0});
+        }
+        Circuit circuit;
+        circuit.addComponents(parts);
+
+        ReducedModel model;
+        bool reduced = ReduceLinearNetwork(circuit, {1, stages + 1}, PrimaOptions(), model);
+        expect(reduced, "PRIMA reduces the ladder");
+        expect(model.reducedOrder > 0 && model.reducedOrder < model.originalOrder, "reduced order is smaller");
+        expect(model.maxRelativeError >= 0.0 && model.maxRelativeError < 0.05, "reduced model matches the ladder");
+
+        // Congruence projection keeps the reduced RC network reciprocal
+        auto z = model.impedance(1e6);
+        expect(z.size() == 4, "two-port impedance");
+        expect(z.size() == 4 && std::abs(z[1] - z[2]) < 1e-6 * std::abs(z[1]), "reciprocal Z12 = Z21");
+    }
+
+    void testFaultSimulation() {
+        // ISCAS-85 c17: every single stuck-at fault is detectable
+        LogicNetlist netlist;
+        int n1 = netlist.addNet("1"), n2 = netlist.addNet("2"), n3 = netlist.addNet("3");
+        int n6 = netlist.addNet("6"), n7 = netlist.addNet("7");
+        for (int net : {n1, n2, n3, n6, n7}) netlist.addInput(net);
+        int n10 = netlist.addNet("10"), n11 = netlist.addNet("11"), n16 = netlist.addNet("16");
+        int n19 = netlist.addNet("19"), n22 = netlist.addNet("22"), n23 = netlist.addNet("23");
+        netlist.addGate("g10", GateType::NAND, {n1, n3}, n10);
+        netlist.addGate("g11", GateType::NAND, {n3, n6}, n11);
+        netlist.addGate("g16", GateType::NAND, {n2, n11}, n16);
+        netlist.addGate("g19", GateType::NAND, {n11, n7}, n19);
+        netlist.addGate("g22", GateType::NAND, {n10, n16}, n22);
+        netlist.addGate("g23", GateType::NAND, {n16, n19}, n23);
+        netlist.addOutput(n22);
+        netlist.addOutput(n23);
+
+        CompiledLogicSim sim(netlist);
+        expect(sim.isCompiled(), "c17 compiles");
+
+        // All 32 input combinations in the low lanes of one word
+        std::vector<PatternWord> inputs(5, 0);
+        for (int pattern = 0; pattern < 32; ++pattern) {
+            for (int bit = 0; bit < 5; ++bit) {
+                if (pattern & (1 << bit)) inputs[bit] |= PatternWord(1) << pattern;
+            }
+        }
+        std::vector<StuckAtFault> faults = CompiledLogicSim::allStuckAtFaults(netlist);
+        std::vector<PatternWord> detected;
+        sim.simulateFaults(inputs, faults, detected);
+        sim.simulateFaults(inputs, faults, detected);  // Second block reuses every buffer
+
+        expect(detected.size() == faults.size(), "one mask per fault");
+        int undetected = 0;
+        for (PatternWord mask : detected) {
+            if ((mask & 0xffffffffULL) == 0) ++undetected;
+        }
+        expect(undetected == 0, "every c17 stuck-at fault is detected");
+    }
+}
+
+int main() {
+    testCountingIsActive();
+    testPrimaReduction();
+    testFaultSimulation();
+    if (failures == 0) std::printf("steady_state_allocations: all checks passed\n");
+    return failures == 0 ? 0 : 1;
+}
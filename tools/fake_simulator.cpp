@@ -0,0 +1,76 @@
+// Stand-in for ngspice/Xyce when exercising ExternalSimulatorBackend. Reads a
+// netlist from the file named on the command line, or from stdin, and speaks the
+// same pipe protocol: result lines on stdout, diagnostics on stderr, exit
+// status 0 on success. Comment directives steer its behaviour:
+//   * fake: sleep <ms>      busy for a while before answering
+//   * fake: alloc <MB>      touch that much memory (trips RLIMIT_AS)
+//   * fake: fail            exit with status 1
+//   * fake: crash           abort()
+//   * fake: hang            never finish (trips the timeout)
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv) {
+    std::ifstream file;
+    if (argc > 1) {
+        file.open(argv[1]);
+        if (!file) {
+            std::cerr << "fake_simulator: cannot open " << argv[1] << std::endl;
+            return 2;
+        }
+    }
+    std::istream& in = argc > 1 ? static_cast<std::istream&>(file) : std::cin;
+
+    int elements = 0, sleepMs = 0, allocMb = 0;
+    bool fail = false, crash = false, hang = false;
+    std::set<std::string> nodes;
+    std::string line;
+    std::getline(in, line);  // Like SPICE, the first line is the title
+    while (std::getline(in, line)) {
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first)) continue;
+        if (first == "*") {
+            std::string tag, directive;
+            if (!(fields >> tag >> directive) || tag != "fake:") continue;
+            if (directive == "sleep") fields >> sleepMs;
+            else if (directive == "alloc") fields >> allocMb;
+            else if (directive == "fail") fail = true;
+            else if (directive == "crash") crash = true;
+            else if (directive == "hang") hang = true;
+            continue;
+        }
+        if (first[0] == '*' || first[0] == '.' || first[0] == '+') continue;
+        std::string a, b;
+        if (fields >> a >> b) {
+            nodes.insert(a);
+            nodes.insert(b);
+        }
+        ++elements;
+    }
+
+    if (sleepMs > 0) std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
+    if (allocMb > 0) {
+        std::vector<char> memory(static_cast<std::size_t>(allocMb) << 20);
+        std::memset(memory.data(), 1, memory.size());
+    }
+    while (hang) std::this_thread::sleep_for(std::chrono::seconds(1));
+    if (crash) std::abort();
+
+    std::cout << "elements " << elements << "\n";
+    std::cout << "nodes " << nodes.size() << "\n";
+    if (fail) {
+        std::cerr << "fake_simulator: failure requested by netlist" << std::endl;
+        return 1;
+    }
+    std::cout << "done" << std::endl;
+    return 0;
+}
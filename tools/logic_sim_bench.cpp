@@ -0,0 +1,82 @@
+// Gate evaluation throughput of the compiled logic simulator.
+//   logic_sim_bench [netlist.v | -] [blocks] [block words]
+// Without a netlist (or with "-") a random levelized circuit is generated. Reports the
+// good-machine regression rate (simulate) and the stuck-at fault simulation
+// rate (simulateFaults) from LogicSimStats.
+#include "parser/verilog_reader.h"
+#include "simulation/logic_sim.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+using namespace Cathedral;
+
+namespace {
+    // inputs primary inputs feeding `gates` 2-input gates, each reading any earlier net
+    LogicNetlist randomCircuit(int inputs, int gates, std::mt19937_64& random) {
+        static const GateType types[] = {GateType::AND, GateType::NAND, GateType::OR,
+                                         GateType::NOR, GateType::XOR, GateType::XNOR};
+        LogicNetlist netlist;
+        for (int i = 0; i < inputs; ++i) {
+            netlist.addInput(netlist.addNet("i" + std::to_string(i)));
+        }
+        for (int g = 0; g < gates; ++g) {
+            std::uniform_int_distribution<int> pick(0, netlist.netCount() - 1);
+            int out = netlist.addNet("n" + std::to_string(g));
+            netlist.addGate("g" + std::to_string(g), types[g % 6], {pick(random), pick(random)}, out);
+            if (g >= gates - 32) netlist.addOutput(out);
+        }
+        return netlist;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string file = argc > 1 ? argv[1] : "";
+    int blocks = argc > 2 ? std::atoi(argv[2]) : 1000;
+    int blockWords = argc > 3 ? std::atoi(argv[3]) : 4;
+
+    std::mt19937_64 random(1);
+    LogicNetlist netlist;
+    if (file.empty() || file == "-") {
+        netlist = randomCircuit(64, 2000, random);
+    } else if (!ReadStructuralVerilogFile(file, netlist)) {
+        return 2;
+    }
+
+    CompiledLogicSim sim(netlist, blockWords);
+    if (!sim.isCompiled()) {
+        return 2;
+    }
+    std::vector<PatternWord> inputs(netlist.getInputs().size() * blockWords), outputs;
+    auto randomize = [&] {
+        for (PatternWord& word : inputs) word = random();
+    };
+
+    for (int b = 0; b < blocks; ++b) {
+        randomize();
+        sim.simulate(inputs, outputs);
+    }
+    LogicSimStats regression = sim.stats();
+
+    // Fault simulation re-runs the circuit per fault, so one block in 100 is plenty
+    std::vector<StuckAtFault> faults = CompiledLogicSim::allStuckAtFaults(netlist);
+    std::vector<PatternWord> detected;
+    sim.resetStats();
+    int faultBlocks = std::max(1, blocks / 100);
+    for (int b = 0; b < faultBlocks; ++b) {
+        randomize();
+        sim.simulateFaults(inputs, faults, detected);
+    }
+    LogicSimStats faultSim = sim.stats();
+
+    std::printf("gates              %zu\n", netlist.getGates().size());
+    std::printf("patterns / block   %d\n", sim.patternsPerBlock());
+    std::printf("faults             %zu\n", faults.size());
+    std::printf("regression         %.3e gate evals/s (%d blocks, %.3f s)\n", regression.evaluationsPerSecond(),
+                blocks, regression.seconds);
+    std::printf("fault simulation   %.3e gate evals/s (%d blocks, %.3f s)\n", faultSim.evaluationsPerSecond(),
+                faultBlocks, faultSim.seconds);
+    return 0;
+}
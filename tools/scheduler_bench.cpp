@@ -0,0 +1,68 @@
+// Throughput and scheduling overhead of JobScheduler on many small jobs.
+//   scheduler_bench [jobs] [workers] [simulator command ...]
+// Without a command the built-in backend runs; pass e.g. bin/fake_simulator
+// to go through the external process pipe protocol instead.
+#include "simulation/job_scheduler.h"
+#include "util/logging.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace Cathedral;
+
+int main(int argc, char** argv) {
+    int jobs = argc > 1 ? std::atoi(argv[1]) : 5000;
+    int workers = argc > 2 ? std::atoi(argv[2]) : 0;
+    std::vector<std::string> command(argv + std::min(argc, 3), argv + argc);
+    // Per-job INFO/WARNING lines would measure the terminal, not the scheduler
+    Logger::SetConsoleLevel(LogLevel::ERROR);
+
+    std::shared_ptr<SimulationBackend> backend;
+    if (command.empty()) {
+        backend = std::make_shared<BuiltinBackend>();
+    } else {
+        backend = std::make_shared<ExternalSimulatorBackend>(command);
+    }
+    JobScheduler scheduler(backend, workers);
+
+    // Driven RC ladders, the size of a typical sweep point or corner run. The
+    // source makes node 1 a port and 24 stages exceed PrimaOptions::minInternalNodes,
+    // so every builtin job runs a real PRIMA reduction.
+    const int stages = 24;
+    for (int i = 0; i < jobs; ++i) {
+        SimulationJob job;
+        job.name = "ladder" + std::to_string(i);
+        job.netlist = "RC ladder " + std::to_string(i) + "\nV1 1 0 1\n";
+        for (int stage = 1; stage <= stages; ++stage) {
+            job.netlist += "R" + std::to_string(stage) + " " + std::to_string(stage) + " " + std::to_string(stage + 1) + " 1k\n";
+            job.netlist += "C" + std::to_string(stage) + " " + std::to_string(stage + 1) + " 0 1p\n";
+        }
+        job.netlist += ".end\n";
+        job.priority = i % 4;
+        job.limits.timeoutSeconds = 10.0;
+        job.limits.memoryBytes = 1ull << 30;
+        scheduler.submit(std::move(job));
+    }
+    scheduler.waitAll();
+
+    SchedulerStats stats = scheduler.stats();
+    // The builtin backend fails a job whose reduction misses targetError, so a
+    // succeeded job with a model line is one PRIMA reduced to spec
+    std::size_t reduced = 0;
+    for (const JobResult& result : scheduler.takeResults()) {
+        if (result.status == JobStatus::Succeeded && result.output.find("\nreduced ") != std::string::npos) ++reduced;
+    }
+    std::printf("backend            %s\n", backend->name().c_str());
+    std::printf("workers            %d\n", scheduler.workerCount());
+    std::printf("jobs               %llu (%llu ok, %llu failed, %llu timed out)\n",
+                static_cast<unsigned long long>(stats.completed()), static_cast<unsigned long long>(stats.succeeded),
+                static_cast<unsigned long long>(stats.failed), static_cast<unsigned long long>(stats.timedOut));
+    if (command.empty()) std::printf("PRIMA to spec      %zu\n", reduced);
+    std::printf("wall               %.3f s\n", stats.wallSeconds);
+    std::printf("throughput         %.1f jobs/s\n", stats.jobsPerSecond());
+    std::printf("mean run           %.1f us\n", stats.completed() ? stats.busySeconds * 1e6 / stats.completed() : 0.0);
+    std::printf("mean queue wait    %.3f ms\n", stats.completed() ? stats.queueSeconds * 1e3 / stats.completed() : 0.0);
+    std::printf("overhead per job   %.2f us\n", stats.overheadPerJobMicroseconds());
+    return stats.succeeded == stats.submitted ? 0 : 1;
+}